@@ -8,6 +8,7 @@ struct Detection {
     int        classId;     // 类别 ID（COCO 0~79）
     float      confidence;  // 置信度 [0,1]
     std::string label;      // 类别名称字符串
+    int        trackId = -1; // 跟踪 ID（SortTracker 分配，-1 = 未跟踪）
 };
 
 using DetectionList = std::vector<Detection>;
\ No newline at end of file
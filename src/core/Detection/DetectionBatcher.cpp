@@ -0,0 +1,107 @@
+#include "DetectionBatcher.h"
+#include <algorithm>
+#include <exception>
+
+DetectionBatcher::DetectionBatcher(DetectorBase& detector, BatcherConfig cfg)
+    : m_detector(detector)
+    , m_cfg(cfg)
+{
+    m_worker = std::thread(&DetectionBatcher::workerLoop, this);
+}
+
+DetectionBatcher::~DetectionBatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+std::future<DetectionList> DetectionBatcher::submit(cv::Mat frame)
+{
+    Pending p;
+    p.frame    = std::move(frame);
+    p.enqueued = std::chrono::steady_clock::now();
+    std::future<DetectionList> result = p.promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(p));
+    }
+    m_cv.notify_one();
+    return result;
+}
+
+void DetectionBatcher::setConfig(BatcherConfig cfg)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cfg = cfg;
+    }
+    m_cv.notify_one();
+}
+
+BatcherConfig DetectionBatcher::config() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg;
+}
+
+double DetectionBatcher::meanBatchSize() const
+{
+    const std::size_t b = m_batches;
+    return b ? static_cast<double>(m_frames) / b : 0.0;
+}
+
+void DetectionBatcher::workerLoop()
+{
+    std::vector<Pending> batch;
+    std::vector<cv::Mat> frames;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;   // 停止且队列已清空
+
+            // 攒批：满批、最早帧超时或停止时发出
+            for (;;) {
+                const std::size_t maxBatch = static_cast<std::size_t>(std::max(1, m_cfg.maxBatch));
+                const auto deadline = m_queue.front().enqueued
+                                    + std::chrono::milliseconds(std::max(0, m_cfg.timeoutMs));
+                if (m_stop || m_queue.size() >= maxBatch
+                    || std::chrono::steady_clock::now() >= deadline)
+                    break;
+                m_cv.wait_until(lock, deadline);
+            }
+
+            const std::size_t n = std::min(m_queue.size(),
+                                           static_cast<std::size_t>(std::max(1, m_cfg.maxBatch)));
+            batch.clear();
+            for (std::size_t i = 0; i < n; ++i) {
+                batch.push_back(std::move(m_queue.front()));
+                m_queue.pop_front();
+            }
+        }
+
+        frames.clear();
+        for (const Pending& p : batch)
+            frames.push_back(p.frame);
+
+        try {
+            std::vector<DetectionList> results = m_detector.detectBatch(frames);
+            results.resize(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i)
+                batch[i].promise.set_value(std::move(results[i]));
+        } catch (...) {
+            for (Pending& p : batch)
+                p.promise.set_exception(std::current_exception());
+        }
+
+        ++m_batches;
+        m_frames += batch.size();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "DetectorBase.h"
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+struct BatcherConfig {
+    int maxBatch  = 8;    // 攒够该帧数立即发出
+    int timeoutMs = 10;   // 最早入队帧等待超过该时长时，未满的批也发出
+};
+
+// 多路输入的批量推理调度：各路（多摄像头/离线多线程）提交单帧，
+// 内部线程将其合并为一次 detectBatch 前向，再按帧拆分结果
+class DetectionBatcher {
+public:
+    explicit DetectionBatcher(DetectorBase& detector, BatcherConfig cfg = {});
+    ~DetectionBatcher();   // 处理完队列中剩余帧后退出
+
+    DetectionBatcher(const DetectionBatcher&) = delete;
+    DetectionBatcher& operator=(const DetectionBatcher&) = delete;
+
+    // 提交一帧（可跨线程调用）；frame 在推理完成前须保持不被改写
+    std::future<DetectionList> submit(cv::Mat frame);
+
+    void setConfig(BatcherConfig cfg);
+    BatcherConfig config() const;
+
+    // 统计：已发出的批数、平均批大小
+    std::size_t batchesRun() const { return m_batches; }
+    double      meanBatchSize() const;
+
+private:
+    struct Pending {
+        cv::Mat                                 frame;
+        std::promise<DetectionList>             promise;
+        std::chrono::steady_clock::time_point   enqueued;
+    };
+
+    void workerLoop();
+
+    DetectorBase&            m_detector;
+    BatcherConfig            m_cfg;
+    std::deque<Pending>      m_queue;
+    mutable std::mutex       m_mutex;
+    std::condition_variable  m_cv;
+    bool                     m_stop = false;
+    std::thread              m_worker;
+
+    std::atomic<std::size_t> m_batches{0};
+    std::atomic<std::size_t> m_frames{0};
+};
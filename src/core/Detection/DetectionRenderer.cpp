@@ -0,0 +1,43 @@
+#include "DetectionRenderer.h"
+#include <algorithm>
+#include <cstdio>
+
+DetectionRenderer::DetectionRenderer(const LabelMap& labels, Style style)
+    : m_labels(labels)
+    , m_style(style)
+{}
+
+void DetectionRenderer::render(cv::Mat& frame, const DetectionList& detections) const
+{
+    for (const auto& d : detections) {
+        const cv::Scalar color = m_labels.colorOf(d.classId);
+        const cv::Rect   box(cv::Point(cvRound(d.bbox.x), cvRound(d.bbox.y)),
+                             cv::Point(cvRound(d.bbox.x + d.bbox.width),
+                                       cvRound(d.bbox.y + d.bbox.height)));
+        cv::rectangle(frame, box, color, m_style.boxThickness);
+
+        if (!m_style.showLabel && !m_style.showScore)
+            continue;
+
+        std::string text;
+        if (m_style.showLabel)
+            text = d.label.empty() ? m_labels.nameOf(d.classId) : d.label;
+        if (d.trackId >= 0)
+            text += (text.empty() ? "#" : " #") + std::to_string(d.trackId);
+        if (m_style.showScore) {
+            char buf[16];
+            std::snprintf(buf, sizeof(buf), "%s%.2f", text.empty() ? "" : " ", d.confidence);
+            text += buf;
+        }
+
+        int baseline = 0;
+        const cv::Size ts = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX,
+                                            m_style.fontScale, m_style.fontThickness, &baseline);
+        const int top = std::max(box.y - ts.height - baseline, 0);
+        cv::rectangle(frame, cv::Rect(box.x, top, ts.width, ts.height + baseline),
+                      color, cv::FILLED);
+        cv::putText(frame, text, cv::Point(box.x, top + ts.height),
+                    cv::FONT_HERSHEY_SIMPLEX, m_style.fontScale,
+                    cv::Scalar(0, 0, 0), m_style.fontThickness, cv::LINE_AA);
+    }
+}
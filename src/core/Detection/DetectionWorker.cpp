@@ -0,0 +1,165 @@
+#include "DetectionWorker.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double kEmaAlpha = 0.2;   // 耗时平均的平滑系数
+}
+
+DetectionWorker::DetectionWorker(DetectorBase& detector)
+    : m_detector(detector)
+{}
+
+DetectionWorker::~DetectionWorker()
+{
+    stop();
+}
+
+void DetectionWorker::start()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_thread.joinable())
+        return;
+    m_stop = false;
+    m_thread = std::thread(&DetectionWorker::threadFunc, this);
+}
+
+void DetectionWorker::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable())
+            return;
+        m_stop = true;
+        m_hasPending = false;
+        m_pending.release();
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+void DetectionWorker::submit(std::uint64_t frameId, double timestampMsec, const cv::Mat& frame,
+                             std::vector<cv::Rect> regions)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_hasPending)
+            ++m_dropped;   // 上一帧尚未开始处理，直接被更新的帧替换
+        m_pending    = frame;
+        m_pendingId  = frameId;
+        m_pendingTs  = timestampMsec;
+        m_pendingRegions = std::move(regions);
+        m_hasPending = true;
+    }
+    m_cv.notify_one();
+}
+
+bool DetectionWorker::latest(DetectionResult& out, std::uint64_t sinceFrameId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_result.frameId == 0 || m_result.frameId <= sinceFrameId)
+        return false;
+    out = m_result;
+    return true;
+}
+
+void DetectionWorker::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hasPending = false;
+    m_pending.release();
+    m_result = DetectionResult{};
+    ++m_generation;
+}
+
+int DetectionWorker::recommendedInterval(double sourceFps) const
+{
+    const double inf = averageInferenceMsec();
+    if (inf <= 0.0 || sourceFps <= 0.0)
+        return 1;
+    // 推理一帧期间源产生的帧数：提交更密只会在邮箱里被覆盖
+    return std::max(1, static_cast<int>(std::ceil(inf * sourceFps / 1000.0)));
+}
+
+DetectionList DetectionWorker::detectRegions(const cv::Mat& frame,
+                                            const std::vector<cv::Rect>& regions)
+{
+    // 各区域裁剪为 ROI 视图（不拷贝）合并为一批推理，框按区域偏移映射回整帧
+    const cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    std::vector<cv::Mat>  crops;
+    std::vector<cv::Rect> used;
+    for (const cv::Rect& r : regions) {
+        const cv::Rect roi = r & frameRect;
+        if (roi.empty())
+            continue;
+        crops.push_back(frame(roi));
+        used.push_back(roi);
+    }
+
+    const std::vector<DetectionList> perRegion = m_detector.detectBatch(crops);
+    DetectionList out;
+    for (std::size_t i = 0; i < perRegion.size() && i < used.size(); ++i) {
+        for (Detection d : perRegion[i]) {
+            d.bbox.x += static_cast<float>(used[i].x);
+            d.bbox.y += static_cast<float>(used[i].y);
+            out.push_back(std::move(d));
+        }
+    }
+    return out;
+}
+
+double DetectionWorker::averageInferenceMsec() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_avgMs;
+}
+
+void DetectionWorker::threadFunc()
+{
+    for (;;) {
+        cv::Mat       frame;
+        std::uint64_t id = 0;
+        double        ts = 0.0;
+        std::uint64_t gen = 0;
+        std::vector<cv::Rect> regions;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || m_hasPending; });
+            if (m_stop)
+                return;
+            frame = std::move(m_pending);
+            m_pending.release();
+            id = m_pendingId;
+            ts = m_pendingTs;
+            gen = m_generation;
+            regions = std::move(m_pendingRegions);
+            m_pendingRegions.clear();
+            m_hasPending = false;
+            m_busy = true;
+        }
+
+        const auto t0 = cv::getTickCount();
+        DetectionList dets;
+        try {
+            dets = regions.empty() ? m_detector.detect(frame)
+                                   : detectRegions(frame, regions);
+        } catch (...) {
+            // 异常不得逃出线程（否则 std::terminate）：本帧按无检测结果发布，m_busy 照常清除
+            dets.clear();
+        }
+        const double ms = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_avgMs = (m_avgMs > 0.0) ? m_avgMs + kEmaAlpha * (ms - m_avgMs) : ms;
+            if (gen == m_generation && id > m_result.frameId) {
+                m_result.frameId       = id;
+                m_result.timestampMsec = ts;
+                m_result.inferenceMsec = ms;
+                m_result.detections    = std::move(dets);
+                m_result.regions       = std::move(regions);
+            }
+            m_busy = false;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "DetectorBase.h"
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 一次检测的结果，附带来源帧的编号与时间戳（结果总是滞后于显示帧）
+struct DetectionResult {
+    std::uint64_t frameId       = 0;
+    double        timestampMsec = 0.0;
+    double        inferenceMsec = 0.0;   // 本次 detect 的总耗时（含前/后处理）
+    DetectionList detections;
+    std::vector<cv::Rect> regions;       // 实际检测的区域（空 = 整帧）
+};
+
+// 异步检测线程：单槽"最新帧"邮箱，新帧覆盖尚未开始处理的旧帧，
+// 推理耗时只影响检测结果的刷新率，不阻塞帧循环
+class DetectionWorker {
+public:
+    explicit DetectionWorker(DetectorBase& detector);
+    ~DetectionWorker();
+
+    DetectionWorker(const DetectionWorker&) = delete;
+    DetectionWorker& operator=(const DetectionWorker&) = delete;
+
+    void start();
+    void stop();    // 丢弃未处理的帧并等待当前推理结束
+
+    // 提交帧（非阻塞）；frame 在处理完成前不得被改写（调用方每帧新读入即可）
+    // regions 非空时只检测这些区域（批量推理），结果映射回整帧坐标
+    void submit(std::uint64_t frameId, double timestampMsec, const cv::Mat& frame,
+                std::vector<cv::Rect> regions = {});
+
+    // 取最新结果；自 sinceFrameId 之后无新结果时返回 false
+    bool latest(DetectionResult& out, std::uint64_t sinceFrameId = 0) const;
+
+    // 清空结果与待处理帧（切换输入源/关闭检测时调用）
+    void reset();
+
+    // 自适应跳帧：按平均推理耗时与源帧率给出两次提交之间的帧间隔（≥ 1）
+    int recommendedInterval(double sourceFps) const;
+
+    bool        busy() const { return m_busy; }
+    double      averageInferenceMsec() const;
+    std::size_t droppedFrames() const { return m_dropped; }
+
+private:
+    void threadFunc();
+    DetectionList detectRegions(const cv::Mat& frame, const std::vector<cv::Rect>& regions);
+
+    DetectorBase&           m_detector;
+
+    // 待处理槽
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_cv;
+    cv::Mat                 m_pending;
+    std::uint64_t           m_pendingId = 0;
+    double                  m_pendingTs = 0.0;
+    std::vector<cv::Rect>   m_pendingRegions;
+    bool                    m_hasPending = false;
+    bool                    m_stop = false;
+    std::uint64_t           m_generation = 0;   // reset() 递增，丢弃此前在途的推理结果
+    std::thread             m_thread;
+
+    // 结果（m_mutex 保护）
+    DetectionResult         m_result;
+    double                  m_avgMs = 0.0;   // 推理耗时指数滑动平均
+
+    std::atomic<bool>        m_busy{false};
+    std::atomic<std::size_t> m_dropped{0};
+};
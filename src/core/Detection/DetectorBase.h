@@ -2,6 +2,7 @@
 #include "Detection.h"
 #include <opencv2/core.hpp>
 #include <string>
+#include <vector>
 
 class DetectorBase {
 public:
@@ -14,6 +15,16 @@ public:
     // 对 frame 执行推理，返回检测结果列表
     virtual DetectionList detect(const cv::Mat& frame) = 0;
 
+    // 批量推理：结果与 frames 一一对应（默认逐帧调用 detect）
+    virtual std::vector<DetectionList> detectBatch(const std::vector<cv::Mat>& frames)
+    {
+        std::vector<DetectionList> results;
+        results.reserve(frames.size());
+        for (const cv::Mat& f : frames)
+            results.push_back(detect(f));
+        return results;
+    }
+
     // 模型是否已加载
     virtual bool isLoaded() const = 0;
 
@@ -0,0 +1,48 @@
+#include "DetectorBenchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+namespace DetectorBenchmark {
+
+Result run(DetectorBase& detector, const std::vector<cv::Mat>& samples, int iterations, int warmup)
+{
+    Result r;
+    if (samples.empty() || iterations <= 0 || !detector.isLoaded())
+        return r;
+
+    for (int i = 0; i < warmup; ++i)
+        detector.detect(samples[static_cast<std::size_t>(i) % samples.size()]);
+
+    std::vector<double> ms;
+    ms.reserve(static_cast<std::size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        const cv::Mat& frame = samples[static_cast<std::size_t>(i) % samples.size()];
+        const auto t0 = cv::getTickCount();
+        const DetectionList dets = detector.detect(frame);
+        ms.push_back((cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency());
+        if (i == iterations - 1)
+            r.detections = dets.size();
+    }
+
+    std::sort(ms.begin(), ms.end());
+    const auto at = [&](double q) {
+        return ms[std::min(ms.size() - 1, static_cast<std::size_t>(q * (ms.size() - 1) + 0.5))];
+    };
+    r.iterations = iterations;
+    r.meanMs = std::accumulate(ms.begin(), ms.end(), 0.0) / ms.size();
+    r.p50Ms  = at(0.50);
+    r.p95Ms  = at(0.95);
+    r.minMs  = ms.front();
+    return r;
+}
+
+std::string format(const std::string& name, const Result& r)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "%-12s n=%d mean=%.2fms p50=%.2fms p95=%.2fms min=%.2fms dets=%zu",
+                  name.c_str(), r.iterations, r.meanMs, r.p50Ms, r.p95Ms, r.minMs, r.detections);
+    return buf;
+}
+
+} // namespace DetectorBenchmark
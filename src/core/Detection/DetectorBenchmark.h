@@ -0,0 +1,27 @@
+#pragma once
+#include "DetectorBase.h"
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+// 推理引擎并排对比：同一组样本帧上测量端到端 detect 耗时（含前/后处理），
+// 用于按机器选择更快的引擎
+namespace DetectorBenchmark {
+
+struct Result {
+    int         iterations = 0;
+    double      meanMs = 0.0;
+    double      p50Ms  = 0.0;
+    double      p95Ms  = 0.0;
+    double      minMs  = 0.0;
+    std::size_t detections = 0;   // 最后一轮的检测总数（用于核对两引擎输出量级一致）
+};
+
+// 依次对 samples 循环调用 detect；前 warmup 次不计时（首次推理含图优化/内存分配）
+Result run(DetectorBase& detector, const std::vector<cv::Mat>& samples,
+           int iterations = 50, int warmup = 5);
+
+// 单行可读摘要
+std::string format(const std::string& name, const Result& r);
+
+} // namespace DetectorBenchmark
@@ -0,0 +1,57 @@
+#include "DetectorEngine.h"
+#include "YOLODetector.h"
+#ifdef RVSFDT_WITH_ONNXRUNTIME
+#include "OnnxRuntimeDetector.h"
+#endif
+
+namespace DetectorEngines {
+
+bool available(DetectorEngine engine)
+{
+    switch (engine) {
+    case DetectorEngine::OpenCvDnn:
+        return true;
+    case DetectorEngine::OnnxRuntime:
+#ifdef RVSFDT_WITH_ONNXRUNTIME
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+std::string name(DetectorEngine engine)
+{
+    return engine == DetectorEngine::OnnxRuntime ? "ort" : "dnn";
+}
+
+bool parse(const std::string& name, DetectorEngine& out)
+{
+    if (name == "dnn") {
+        out = DetectorEngine::OpenCvDnn;
+        return true;
+    }
+    if (name == "ort") {
+        out = DetectorEngine::OnnxRuntime;
+        return true;
+    }
+    return false;
+}
+
+std::unique_ptr<DetectorBase> create(DetectorEngine engine)
+{
+    switch (engine) {
+    case DetectorEngine::OpenCvDnn:
+        return std::make_unique<YOLODetector>();
+    case DetectorEngine::OnnxRuntime:
+#ifdef RVSFDT_WITH_ONNXRUNTIME
+        return std::make_unique<OnnxRuntimeDetector>();
+#else
+        break;
+#endif
+    }
+    return nullptr;
+}
+
+} // namespace DetectorEngines
@@ -0,0 +1,23 @@
+#pragma once
+#include "DetectorBase.h"
+#include <memory>
+#include <string>
+
+// 可选推理引擎：OpenCvDnn 始终可用；OnnxRuntime 需以 RVSFDT_WITH_ONNXRUNTIME 构建
+enum class DetectorEngine { OpenCvDnn, OnnxRuntime };
+
+namespace DetectorEngines {
+
+// 当前构建是否包含该引擎
+bool available(DetectorEngine engine);
+
+// 短名称（"dnn" / "ort"），用于命令行与日志
+std::string name(DetectorEngine engine);
+
+// 由短名称解析；无法识别返回 false
+bool parse(const std::string& name, DetectorEngine& out);
+
+// 以默认配置创建检测器（未加载模型）；引擎不可用时返回 nullptr
+std::unique_ptr<DetectorBase> create(DetectorEngine engine);
+
+} // namespace DetectorEngines
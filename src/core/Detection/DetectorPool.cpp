@@ -0,0 +1,285 @@
+#include "DetectorPool.h"
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+DetectorPool::DetectorPool(Factory factory, DetectorPoolConfig cfg)
+    : m_cfg(cfg)
+{
+    const std::vector<int> cores = availableCores();
+    const int avail   = static_cast<int>(cores.size());
+    const int threads = std::max(1, m_cfg.threadsPerInstance);
+    const int count   = m_cfg.instances > 0 ? m_cfg.instances : std::max(1, avail / threads);
+
+    for (int i = 0; i < count; ++i) {
+        auto inst = std::make_unique<Instance>();
+        // 核子集按实例序号在可用核中连续划分，实例数 × 预算超过核数时回绕
+        if (m_cfg.pinThreads) {
+            for (int c = 0; c < threads; ++c)
+                inst->cores.push_back(cores[static_cast<std::size_t>((i * threads + c) % avail)]);
+        }
+        inst->detector = factory(i, threads, inst->cores);
+        m_instances.push_back(std::move(inst));
+    }
+    for (auto& inst : m_instances)
+        inst->thread = std::thread(&DetectorPool::workerLoop, this, std::ref(*inst));
+}
+
+DetectorPool::~DetectorPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workCv.notify_all();
+    m_spaceCv.notify_all();
+    for (auto& inst : m_instances)
+        if (inst->thread.joinable())
+            inst->thread.join();
+}
+
+std::vector<int> DetectorPool::availableCores()
+{
+    std::vector<int> cores;
+#ifdef _WIN32
+    DWORD_PTR procMask = 0, sysMask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &procMask, &sysMask)) {
+        for (int c = 0; c < static_cast<int>(sizeof(DWORD_PTR) * 8); ++c)
+            if (procMask & (DWORD_PTR(1) << c))
+                cores.push_back(c);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &set))
+                cores.push_back(c);
+    }
+#endif
+    if (cores.empty()) {
+        const int hw = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        for (int c = 0; c < hw; ++c)
+            cores.push_back(c);
+    }
+    return cores;
+}
+
+void DetectorPool::pinCurrentThread(const std::vector<int>& cores)
+{
+    if (cores.empty())
+        return;
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (int c : cores)
+        if (c < static_cast<int>(sizeof(DWORD_PTR) * 8))
+            mask |= DWORD_PTR(1) << c;
+    if (mask)
+        SetThreadAffinityMask(GetCurrentThread(), mask);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cores)
+        CPU_SET(c, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+bool DetectorPool::loadModel(const std::string& modelPath, const std::string& labelsPath)
+{
+    // 各实例独立加载（互不共享网络权重缓冲）
+    bool ok = !m_instances.empty();
+    for (auto& inst : m_instances)
+        ok = inst->detector->loadModel(modelPath, labelsPath) && ok;
+    return ok;
+}
+
+bool DetectorPool::isLoaded() const
+{
+    return std::all_of(m_instances.begin(), m_instances.end(),
+                       [](const auto& inst) { return inst->detector->isLoaded(); });
+}
+
+void DetectorPool::setConfThreshold(float t)
+{
+    for (auto& inst : m_instances)
+        inst->detector->setConfThreshold(t);
+}
+
+float DetectorPool::confThreshold() const
+{
+    return m_instances.empty() ? 0.0f : m_instances.front()->detector->confThreshold();
+}
+
+void DetectorPool::setNmsThreshold(float t)
+{
+    for (auto& inst : m_instances)
+        inst->detector->setNmsThreshold(t);
+}
+
+float DetectorPool::nmsThreshold() const
+{
+    return m_instances.empty() ? 0.0f : m_instances.front()->detector->nmsThreshold();
+}
+
+std::size_t DetectorPool::processed(int instance) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_instances.at(static_cast<std::size_t>(instance))->processed;
+}
+
+int DetectorPool::pickInstance() const
+{
+    const int n     = static_cast<int>(m_instances.size());
+    const int depth = std::max(1, m_cfg.queueDepth);
+    const auto load = [&](int i) {
+        const Instance& inst = *m_instances[static_cast<std::size_t>(i)];
+        return static_cast<int>(inst.queue.size()) + inst.busy;
+    };
+
+    if (m_cfg.policy == DispatchPolicy::RoundRobin) {
+        for (int k = 0; k < n; ++k) {
+            const int i = (m_rr + k) % n;
+            if (static_cast<int>(m_instances[static_cast<std::size_t>(i)]->queue.size()) < depth) {
+                m_rr = (i + 1) % n;
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int best = -1;
+    for (int i = 0; i < n; ++i) {
+        if (static_cast<int>(m_instances[static_cast<std::size_t>(i)]->queue.size()) >= depth)
+            continue;
+        if (best < 0 || load(i) < load(best))
+            best = i;
+    }
+    return best;
+}
+
+std::future<DetectionList> DetectorPool::dispatch(cv::Mat frame)
+{
+    Job job;
+    job.frame = std::move(frame);
+    std::future<DetectionList> result = job.promise.get_future();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    int target = -1;
+    m_spaceCv.wait(lock, [&] { return m_stop || (target = pickInstance()) >= 0; });
+    if (m_stop) {
+        job.promise.set_value({});
+        return result;
+    }
+    m_instances[static_cast<std::size_t>(target)]->queue.push_back(std::move(job));
+    lock.unlock();
+    m_workCv.notify_all();
+    return result;
+}
+
+DetectionList DetectorPool::detect(const cv::Mat& frame)
+{
+    return dispatch(frame).get();
+}
+
+std::vector<DetectionList> DetectorPool::detectBatch(const std::vector<cv::Mat>& frames)
+{
+    // 全部分发后按原顺序等待，结果顺序与 frames 一致
+    std::vector<std::future<DetectionList>> futures;
+    futures.reserve(frames.size());
+    for (const cv::Mat& f : frames)
+        futures.push_back(dispatch(f));
+
+    std::vector<DetectionList> results;
+    results.reserve(frames.size());
+    for (auto& fut : futures)
+        results.push_back(fut.get());
+    return results;
+}
+
+std::uint64_t DetectorPool::submit(cv::Mat frame)
+{
+    std::lock_guard<std::mutex> lock(m_orderMutex);
+    const std::uint64_t seq = m_nextSeq++;
+    m_ordered.emplace_back(seq, dispatch(std::move(frame)));
+    return seq;
+}
+
+bool DetectorPool::popOrdered(DetectionList& out, std::uint64_t* seq, int timeoutMs)
+{
+    // 队首结果在锁外等待：推理期间 submit() 与其它取结果的线程不被阻塞
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;) {
+        std::uint64_t                     frontSeq;
+        std::shared_future<DetectionList> fut;
+        {
+            std::lock_guard<std::mutex> lock(m_orderMutex);
+            if (m_ordered.empty())
+                return false;
+            frontSeq = m_ordered.front().first;
+            fut      = m_ordered.front().second;
+        }
+
+        if (timeoutMs < 0)
+            fut.wait();
+        else if (fut.wait_until(deadline) != std::future_status::ready)
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_orderMutex);
+            // 等待期间已被其它线程取走：继续等待下一个
+            if (m_ordered.empty() || m_ordered.front().first != frontSeq)
+                continue;
+            m_ordered.pop_front();
+        }
+        out = fut.get();
+        if (seq)
+            *seq = frontSeq;
+        return true;
+    }
+}
+
+void DetectorPool::workerLoop(Instance& inst)
+{
+    pinCurrentThread(inst.cores);
+
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCv.wait(lock, [&] { return m_stop || !inst.queue.empty(); });
+            if (m_stop && inst.queue.empty())
+                return;
+            job = std::move(inst.queue.front());
+            inst.queue.pop_front();
+            inst.busy = 1;
+        }
+        m_spaceCv.notify_one();
+
+        try {
+            job.promise.set_value(inst.detector->detect(job.frame));
+        } catch (...) {
+            job.promise.set_exception(std::current_exception());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            inst.busy = 0;
+            ++inst.processed;
+        }
+        // 最少负载策略下空闲实例可能成为更优目标
+        m_spaceCv.notify_one();
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "DetectorBase.h"
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class DispatchPolicy { RoundRobin, LeastLoaded };
+
+struct DetectorPoolConfig {
+    int            instances          = 0;    // 0 = 进程可用核数 / threadsPerInstance
+    int            threadsPerInstance = 1;    // 每个实例的线程预算（亦为绑定的核数）
+    bool           pinThreads         = true; // 实例工作线程绑定到各自的核子集
+    DispatchPolicy policy             = DispatchPolicy::LeastLoaded;
+    int            queueDepth         = 2;    // 每实例排队上限，全满时 submit 阻塞
+};
+
+// 检测器实例池：N 个独立网络实例各占一组核，帧按轮询或最少负载分发，
+// 结果按提交顺序交付。自身也实现 DetectorBase，可直接替换单实例检测器
+//
+// 核子集取自进程的 CPU 亲和性掩码（而非 hardware_concurrency），容器/taskset 限制下不会绑到不可用的核。
+// 绑核只作用于各实例的工作线程：cv::dnn 的 parallel_for_ 使用进程级共享线程池，
+// 其工作线程无法按实例绑定，池忙时并发调用退化为在实例线程上串行执行，
+// 因此 cv::dnn 实例以默认的 threadsPerInstance = 1 横向扩展，推理即在已绑核的实例线程上进行；
+// ONNX Runtime 等自带线程池的引擎在工厂中按 threads / cores 设置 intra-op 线程数与亲和性
+class DetectorPool : public DetectorBase {
+public:
+    // 工厂：index 为实例序号，threads 为该实例的线程预算，cores 为分配给它的核（pinThreads 为 false 时为空）
+    using Factory = std::function<std::unique_ptr<DetectorBase>(int index, int threads,
+                                                                const std::vector<int>& cores)>;
+
+    explicit DetectorPool(Factory factory, DetectorPoolConfig cfg = {});
+    ~DetectorPool() override;
+
+    DetectorPool(const DetectorPool&) = delete;
+    DetectorPool& operator=(const DetectorPool&) = delete;
+
+    // ──── DetectorBase ────
+    bool loadModel(const std::string& modelPath, const std::string& labelsPath = "") override;
+    DetectionList detect(const cv::Mat& frame) override;
+    std::vector<DetectionList> detectBatch(const std::vector<cv::Mat>& frames) override;
+    bool  isLoaded() const override;
+    void  setConfThreshold(float t) override;
+    float confThreshold() const override;
+    void  setNmsThreshold(float t) override;
+    float nmsThreshold() const override;
+
+    // ──── 流式接口：提交后按提交顺序取回 ────
+    std::uint64_t submit(cv::Mat frame);
+    // 取下一个（按提交顺序）结果；timeoutMs < 0 为无限等待。无待取结果或超时返回 false
+    bool popOrdered(DetectionList& out, std::uint64_t* seq = nullptr, int timeoutMs = -1);
+
+    int         instanceCount() const { return static_cast<int>(m_instances.size()); }
+    std::size_t processed(int instance) const;
+
+private:
+    struct Job {
+        cv::Mat                     frame;
+        std::promise<DetectionList> promise;
+    };
+
+    struct Instance {
+        std::unique_ptr<DetectorBase> detector;
+        std::deque<Job>               queue;     // m_mutex 保护
+        int                           busy = 0;  // 正在推理的帧数（0/1）
+        std::size_t                   processed = 0;
+        std::vector<int>              cores;
+        std::thread                   thread;
+    };
+
+    std::future<DetectionList> dispatch(cv::Mat frame);
+    int  pickInstance() const;    // 调用方持有 m_mutex；无空位返回 -1
+    void workerLoop(Instance& inst);
+    static void pinCurrentThread(const std::vector<int>& cores);
+    static std::vector<int> availableCores();   // 进程亲和性掩码中的逻辑核编号
+
+    DetectorPoolConfig                     m_cfg;
+    std::vector<std::unique_ptr<Instance>> m_instances;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_workCv;    // 有新任务
+    std::condition_variable m_spaceCv;   // 有排队空位
+    bool                    m_stop = false;
+    mutable int             m_rr   = 0;
+
+    // 流式接口的有序结果；shared_future 便于在锁外等待队首结果
+    std::mutex                                                        m_orderMutex;
+    std::deque<std::pair<std::uint64_t, std::shared_future<DetectionList>>> m_ordered;
+    std::uint64_t                                                     m_nextSeq = 0;
+};
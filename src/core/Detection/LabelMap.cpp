@@ -0,0 +1,72 @@
+#include "LabelMap.h"
+#include <algorithm>
+#include <fstream>
+
+bool LabelMap::loadFromFile(const std::string& path)
+{
+    std::ifstream ifs(path);
+    if (!ifs)
+        return false;
+
+    std::vector<std::string> names;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        // 兼容 Windows 换行
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            names.push_back(line);
+    }
+    if (names.empty())
+        return false;
+
+    m_names = std::move(names);
+    m_colors.clear();
+    return true;
+}
+
+void LabelMap::loadCOCO80()
+{
+    m_names = {
+        "person", "bicycle", "car", "motorcycle", "airplane", "bus", "train", "truck",
+        "boat", "traffic light", "fire hydrant", "stop sign", "parking meter", "bench",
+        "bird", "cat", "dog", "horse", "sheep", "cow", "elephant", "bear", "zebra",
+        "giraffe", "backpack", "umbrella", "handbag", "tie", "suitcase", "frisbee",
+        "skis", "snowboard", "sports ball", "kite", "baseball bat", "baseball glove",
+        "skateboard", "surfboard", "tennis racket", "bottle", "wine glass", "cup",
+        "fork", "knife", "spoon", "bowl", "banana", "apple", "sandwich", "orange",
+        "broccoli", "carrot", "hot dog", "pizza", "donut", "cake", "chair", "couch",
+        "potted plant", "bed", "dining table", "toilet", "tv", "laptop", "mouse",
+        "remote", "keyboard", "cell phone", "microwave", "oven", "toaster", "sink",
+        "refrigerator", "book", "clock", "vase", "scissors", "teddy bear",
+        "hair drier", "toothbrush"
+    };
+    m_colors.clear();
+}
+
+const std::string& LabelMap::nameOf(int classId) const
+{
+    static const std::string unknown = "unknown";
+    if (classId < 0 || classId >= size())
+        return unknown;
+    return m_names[static_cast<std::size_t>(classId)];
+}
+
+int LabelMap::size() const
+{
+    return static_cast<int>(m_names.size());
+}
+
+cv::Scalar LabelMap::colorOf(int classId) const
+{
+    if (m_colors.empty()) {
+        // 固定种子，保证同一类别每次运行颜色一致
+        cv::RNG rng(0x5EED);
+        m_colors.reserve(std::max<std::size_t>(m_names.size(), 1));
+        for (std::size_t i = 0; i < std::max<std::size_t>(m_names.size(), 1); ++i)
+            m_colors.emplace_back(rng.uniform(64, 256), rng.uniform(64, 256), rng.uniform(64, 256));
+    }
+    if (classId < 0)
+        classId = 0;
+    return m_colors[static_cast<std::size_t>(classId) % m_colors.size()];
+}
@@ -0,0 +1,180 @@
+#include "MotionGate.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+MotionGate::MotionGate(MotionGateConfig cfg)
+    : m_cfg(cfg)
+{}
+
+void MotionGate::reset()
+{
+    m_prev.release();
+    m_source    = cv::Size();
+    m_sinceFull = 0;
+}
+
+MotionDecision MotionGate::evaluate(const cv::Mat& frame)
+{
+    MotionDecision d;
+    if (frame.empty()) {
+        d.mode = MotionDecision::Mode::Skip;
+        return d;
+    }
+    ++m_evaluations;
+
+    // 1. 缩小 + 灰度 + 轻度平滑（抑制传感器噪声）
+    const double scale = std::min(1.0, m_cfg.analysisWidth / static_cast<double>(frame.cols));
+    const cv::Mat* img = &frame;
+    if (scale < 1.0) {
+        cv::resize(frame, m_small, cv::Size(), scale, scale, cv::INTER_AREA);
+        img = &m_small;
+    }
+    if (img->channels() == 1)
+        img->copyTo(m_gray);
+    else
+        cv::cvtColor(*img, m_gray, img->channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+    cv::GaussianBlur(m_gray, m_gray, cv::Size(5, 5), 0);
+
+    // 首帧、分辨率变化或到达刷新周期：整帧检测（覆盖静止目标）
+    const bool refresh = m_prev.empty() || m_source != frame.size()
+                      || m_sinceFull >= m_cfg.refreshInterval;
+    if (refresh) {
+        std::swap(m_prev, m_gray);
+        m_source    = frame.size();
+        m_sinceFull = 0;
+        return d;
+    }
+
+    // 2. 帧差掩码
+    cv::absdiff(m_gray, m_prev, m_mask);
+    std::swap(m_prev, m_gray);
+    cv::threshold(m_mask, m_mask, m_cfg.diffThreshold, 255, cv::THRESH_BINARY);
+    cv::dilate(m_mask, m_mask, cv::Mat(), cv::Point(-1, -1), 2);
+    d.motionFraction = cv::countNonZero(m_mask) / static_cast<double>(m_mask.total());
+
+    if (d.motionFraction < m_cfg.minMotionFraction) {
+        d.mode = MotionDecision::Mode::Skip;
+        ++m_sinceFull;
+        ++m_skipped;
+        return d;
+    }
+    if (d.motionFraction > m_cfg.fullFrameFraction) {
+        m_sinceFull = 0;
+        return d;
+    }
+
+    // 3. 运动连通域 → 源坐标区域（外扩、保证最小尺寸、裁剪到帧内）
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(m_mask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    const cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    const double inv = 1.0 / scale;
+    std::vector<cv::Rect> rects;
+    for (const auto& c : contours) {
+        const cv::Rect r = cv::boundingRect(c);
+        const cv::Rect clipped = padRegion(cv::Rect2d(r.x * inv, r.y * inv, r.width * inv, r.height * inv),
+                                           frameRect);
+        if (!clipped.empty())
+            rects.push_back(clipped);
+    }
+    return decide(rects, frameRect, d);
+}
+
+MotionDecision MotionGate::evaluateRegions(const std::vector<cv::Rect>& changed, cv::Size frameSize)
+{
+    MotionDecision d;
+    if (frameSize.empty()) {
+        d.mode = MotionDecision::Mode::Skip;
+        return d;
+    }
+    ++m_evaluations;
+
+    // 首次、分辨率变化或到达刷新周期：整帧检测。帧差基准随之失效
+    if (m_source != frameSize || m_sinceFull >= m_cfg.refreshInterval) {
+        m_prev.release();
+        m_source    = frameSize;
+        m_sinceFull = 0;
+        return d;
+    }
+
+    const cv::Rect frameRect(0, 0, frameSize.width, frameSize.height);
+    std::vector<cv::Rect> rects;
+    double area = 0.0;
+    for (const cv::Rect& r : changed) {
+        const cv::Rect clipped = r & frameRect;
+        if (clipped.empty())
+            continue;
+        area += clipped.area();
+        const cv::Rect padded = padRegion(cv::Rect2d(clipped), frameRect);
+        if (!padded.empty())
+            rects.push_back(padded);
+    }
+    d.motionFraction = std::min(1.0, area / frameRect.area());   // 区域可能相互重叠
+
+    if (d.motionFraction < m_cfg.minMotionFraction) {
+        d.mode = MotionDecision::Mode::Skip;
+        ++m_sinceFull;
+        ++m_skipped;
+        return d;
+    }
+    if (d.motionFraction > m_cfg.fullFrameFraction) {
+        m_sinceFull = 0;
+        return d;
+    }
+    return decide(rects, frameRect, d);
+}
+
+cv::Rect MotionGate::padRegion(const cv::Rect2d& r, const cv::Rect& frameRect) const
+{
+    const double cx = r.x + r.width  * 0.5;
+    const double cy = r.y + r.height * 0.5;
+    const double w  = std::max(r.width  * (1.0 + 2.0 * m_cfg.padding), static_cast<double>(m_cfg.minRegionSize));
+    const double h  = std::max(r.height * (1.0 + 2.0 * m_cfg.padding), static_cast<double>(m_cfg.minRegionSize));
+    const cv::Rect region(cvRound(cx - w * 0.5), cvRound(cy - h * 0.5), cvRound(w), cvRound(h));
+    return region & frameRect;
+}
+
+MotionDecision MotionGate::decide(std::vector<cv::Rect>& rects, const cv::Rect& frameRect, MotionDecision d)
+{
+    mergeRegions(rects);
+
+    double area = 0.0;
+    for (const cv::Rect& r : rects)
+        area += r.area();
+    if (rects.empty() || area > m_cfg.fullFrameFraction * frameRect.area()) {
+        m_sinceFull = 0;
+        return d;
+    }
+
+    d.mode    = MotionDecision::Mode::Regions;
+    d.regions = std::move(rects);
+    ++m_sinceFull;
+    ++m_regional;
+    return d;
+}
+
+void MotionGate::mergeRegions(std::vector<cv::Rect>& rects) const
+{
+    // 相交区域反复合并为外接矩形，直到两两不相交（保证同一目标不被两次检测）
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (std::size_t i = 0; i < rects.size() && !merged; ++i) {
+            for (std::size_t j = i + 1; j < rects.size(); ++j) {
+                if ((rects[i] & rects[j]).area() > 0) {
+                    rects[i] |= rects[j];
+                    rects.erase(rects.begin() + static_cast<std::ptrdiff_t>(j));
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (static_cast<int>(rects.size()) > m_cfg.maxRegions) {
+        cv::Rect all = rects.front();
+        for (const cv::Rect& r : rects)
+            all |= r;
+        rects.assign(1, all);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <vector>
+
+struct MotionGateConfig {
+    int    analysisWidth     = 160;     // 运动分析的缩小宽度（像素）
+    int    diffThreshold     = 20;      // 帧差二值化阈值（8U）
+    double minMotionFraction = 0.001;   // 运动像素占比低于该值视为静止，跳过检测
+    double fullFrameFraction = 0.35;    // 运动区域总面积占比超过该值时改为整帧检测
+    double padding           = 0.25;    // 区域外扩比例（按区域边长）
+    int    minRegionSize     = 160;     // 区域最小边长（源像素），避免过小裁剪被大倍数放大
+    int    maxRegions        = 4;       // 超过时合并为单个外接区域
+    int    refreshInterval   = 90;      // 距上次整帧检测的评估次数达到该值时强制整帧
+};
+
+struct MotionDecision {
+    enum class Mode { Skip, Regions, FullFrame };
+    Mode                  mode = Mode::FullFrame;
+    std::vector<cv::Rect> regions;            // Regions 模式下的检测区域（源坐标，互不重叠）
+    double                motionFraction = 0.0;
+};
+
+// 运动门控：在缩小的灰度帧上做帧差，决定本次是否需要检测、检测哪些区域。
+// 固定机位的静止场景中检测开销趋近于零，开销随实际活动范围增长
+class MotionGate {
+public:
+    explicit MotionGate(MotionGateConfig cfg = {});
+
+    void setConfig(MotionGateConfig cfg) { m_cfg = cfg; }
+    MotionGateConfig config() const { return m_cfg; }
+
+    // 与上一次评估的帧比较（应按检测提交节奏调用，而非每帧）
+    MotionDecision evaluate(const cv::Mat& frame);
+    // 源已给出自上次评估以来的变化区域（ScreenSource 的 XDamage）：跳过帧差，直接按区域决策
+    MotionDecision evaluateRegions(const std::vector<cv::Rect>& changed, cv::Size frameSize);
+
+    void reset();
+
+    // 统计：评估次数与各模式次数
+    std::size_t evaluations() const { return m_evaluations; }
+    std::size_t skipped()     const { return m_skipped; }
+    std::size_t regional()    const { return m_regional; }
+
+private:
+    void mergeRegions(std::vector<cv::Rect>& rects) const;
+    // 变化区域（源坐标）外扩、保证最小尺寸并裁剪到帧内
+    cv::Rect padRegion(const cv::Rect2d& r, const cv::Rect& frameRect) const;
+    // 合并候选区域并给出 Regions / FullFrame 决策
+    MotionDecision decide(std::vector<cv::Rect>& rects, const cv::Rect& frameRect, MotionDecision d);
+
+    MotionGateConfig m_cfg;
+    cv::Mat          m_small;   // 缩小帧
+    cv::Mat          m_gray;    // 当前灰度
+    cv::Mat          m_prev;    // 上次评估的灰度
+    cv::Mat          m_mask;
+    cv::Size         m_source;
+    int              m_sinceFull = 0;
+
+    std::size_t      m_evaluations = 0;
+    std::size_t      m_skipped     = 0;
+    std::size_t      m_regional    = 0;
+};
@@ -0,0 +1,80 @@
+#include "NetCache.h"
+#include <algorithm>
+#include <filesystem>
+
+NetKey NetKey::make(const std::string& path, int backendId, int targetId, cv::Size inputSize)
+{
+    NetKey key;
+    key.path      = path;
+    key.backendId = backendId;
+    key.targetId  = targetId;
+    key.inputSize = inputSize;
+
+    std::error_code ec;
+    const auto t = std::filesystem::last_write_time(path, ec);
+    if (!ec)
+        key.stamp = static_cast<std::int64_t>(t.time_since_epoch().count());
+    return key;
+}
+
+bool NetKey::operator==(const NetKey& o) const
+{
+    return path == o.path && stamp == o.stamp && backendId == o.backendId
+        && targetId == o.targetId && inputSize == o.inputSize;
+}
+
+NetCache& NetCache::instance()
+{
+    static NetCache cache;
+    return cache;
+}
+
+bool NetCache::take(const NetKey& key, cv::dnn::Net& net)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                                 [&](const Entry& e) { return e.key == key; });
+    if (it == m_entries.end())
+        return false;
+    net = it->net;
+    m_entries.erase(it);
+    return true;
+}
+
+void NetCache::put(const NetKey& key, const cv::dnn::Net& net)
+{
+    if (net.empty())
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_capacity == 0)
+        return;
+    m_entries.push_front({key, net});
+    while (m_entries.size() > m_capacity)
+        m_entries.pop_back();
+}
+
+void NetCache::setCapacity(std::size_t n)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = n;
+    while (m_entries.size() > m_capacity)
+        m_entries.pop_back();
+}
+
+std::size_t NetCache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+std::size_t NetCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+void NetCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+
+// 网络缓存键：模型文件（含修改时间）+ 后端/目标 + 输入尺寸
+struct NetKey {
+    std::string  path;
+    std::int64_t stamp     = 0;   // 文件修改时间，模型被覆盖后旧条目自然失效
+    int          backendId = 0;
+    int          targetId  = 0;
+    cv::Size     inputSize;
+
+    static NetKey make(const std::string& path, int backendId, int targetId, cv::Size inputSize);
+    bool operator==(const NetKey& o) const;
+};
+
+// 进程内已加载（且已预热）网络的缓存，按 LRU 淘汰
+// 采用借出/归还语义：take 将条目移出缓存，同一 Net 不会被两个检测器同时持有
+class NetCache {
+public:
+    static NetCache& instance();
+
+    bool take(const NetKey& key, cv::dnn::Net& net);   // 命中则移出并返回 true
+    void put(const NetKey& key, const cv::dnn::Net& net);
+
+    void        setCapacity(std::size_t n);   // 0 = 禁用缓存
+    std::size_t capacity() const;
+    std::size_t size() const;
+    void        clear();
+
+private:
+    NetCache() = default;
+
+    struct Entry {
+        NetKey       key;
+        cv::dnn::Net net;
+    };
+
+    mutable std::mutex m_mutex;
+    std::list<Entry>   m_entries;        // 头部为最近归还
+    std::size_t        m_capacity = 4;
+};
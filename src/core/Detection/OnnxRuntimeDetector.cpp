@@ -0,0 +1,276 @@
+#include "OnnxRuntimeDetector.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+
+// YOLOv8 各检测头的锚点总数（stride 8/16/32），输出维度为动态时据此推断
+int64_t anchorsFor(int w, int h)
+{
+    int64_t n = 0;
+    for (int s : { 8, 16, 32 })
+        n += static_cast<int64_t>(w / s) * (h / s);
+    return n;
+}
+
+} // namespace
+
+OnnxRuntimeDetector::OnnxRuntimeDetector(OrtConfig cfg)
+    : m_cfg(cfg)
+    , m_env(ORT_LOGGING_LEVEL_WARNING, "RVSFDT")
+    , m_memInfo(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault))
+    , m_pre(cv::Size(cfg.inputWidth, cfg.inputHeight))
+{
+    m_labels.loadCOCO80();
+}
+
+OnnxRuntimeDetector::~OnnxRuntimeDetector() = default;
+
+std::string OnnxRuntimeDetector::resolveModelPath(const std::string& path, OrtPrecision precision)
+{
+    if (precision != OrtPrecision::Int8)
+        return path;
+
+    const std::filesystem::path p(path);
+    const std::string stem = p.stem().string();
+    if (stem.size() >= 5 && stem.compare(stem.size() - 5, 5, "_int8") == 0)
+        return path;
+
+    const std::filesystem::path quantized = p.parent_path() / (stem + "_int8" + p.extension().string());
+    std::error_code ec;
+    return std::filesystem::exists(quantized, ec) ? quantized.string() : path;
+}
+
+bool OnnxRuntimeDetector::loadModel(const std::string& modelPath, const std::string& labelsPath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loaded = false;
+    m_binding.reset();
+    m_session.reset();
+    m_boundCount = 0;
+    m_boundInput = nullptr;
+
+    const std::string path = resolveModelPath(modelPath, m_cfg.precision);
+
+    // 类别表先于会话加载：输出的类别维为动态时据其推断
+    if (labelsPath.empty() || !m_labels.loadFromFile(labelsPath))
+        m_labels.loadCOCO80();
+
+    try {
+        Ort::SessionOptions opts;
+        opts.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+        if (m_cfg.intraOpThreads > 0)
+            opts.SetIntraOpNumThreads(m_cfg.intraOpThreads);
+        if (m_cfg.intraOpThreads > 1
+            && m_cfg.intraOpCores.size() >= static_cast<std::size_t>(m_cfg.intraOpThreads)) {
+            // 每线程一项、以分号分隔；ORT 的处理器编号从 1 开始
+            std::string affinity;
+            for (int t = 1; t < m_cfg.intraOpThreads; ++t) {
+                if (!affinity.empty())
+                    affinity += ';';
+                affinity += std::to_string(m_cfg.intraOpCores[static_cast<std::size_t>(t)] + 1);
+            }
+            opts.AddConfigEntry("session.intra_op_thread_affinities", affinity.c_str());
+        }
+        if (m_cfg.parallelExecution) {
+            opts.SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+            opts.SetInterOpNumThreads(std::max(1, m_cfg.interOpThreads));
+        } else {
+            opts.SetExecutionMode(ExecutionMode::ORT_SEQUENTIAL);
+        }
+
+        // Windows 下 ORTCHAR_T 为 wchar_t，经 filesystem::path 转换
+        const std::filesystem::path fsPath(path);
+        m_session = std::make_unique<Ort::Session>(m_env, fsPath.c_str(), opts);
+
+        Ort::AllocatorWithDefaultOptions alloc;
+        m_inputName  = m_session->GetInputNameAllocated(0, alloc).get();
+        m_outputName = m_session->GetOutputNameAllocated(0, alloc).get();
+
+        // 量化模型（QDQ / 动态量化）的输入输出仍为 float，其余类型不支持
+        const auto inInfo = m_session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo();
+        if (inInfo.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+            m_session.reset();
+            return false;
+        }
+        const std::vector<int64_t> inShape = inInfo.GetShape();
+        m_dynamicBatch = !inShape.empty() && inShape[0] < 0;
+        if (inShape.size() == 4 && inShape[2] > 0 && inShape[3] > 0) {
+            m_cfg.inputHeight = static_cast<int>(inShape[2]);
+            m_cfg.inputWidth  = static_cast<int>(inShape[3]);
+        }
+        m_pre.setInputSize(cv::Size(m_cfg.inputWidth, m_cfg.inputHeight));
+
+        const auto outInfo = m_session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo();
+        m_outputShape = outInfo.GetShape();
+        if (m_outputShape.size() != 3)
+            throw Ort::Exception("unexpected output rank", ORT_INVALID_GRAPH);
+        if (m_outputShape[1] < 0)
+            m_outputShape[1] = 4 + m_labels.size();
+        if (m_outputShape[2] < 0)
+            m_outputShape[2] = anchorsFor(m_cfg.inputWidth, m_cfg.inputHeight);
+    } catch (const Ort::Exception&) {
+        m_session.reset();
+        return false;
+    }
+
+    m_binding   = std::make_unique<Ort::IoBinding>(*m_session);
+    m_modelPath = path;
+    m_loaded    = true;
+    return true;
+}
+
+void OnnxRuntimeDetector::bind(int count)
+{
+    const cv::Mat& blob = m_pre.prepare(count);
+    const float* input = blob.ptr<float>();
+    if (count == m_boundCount && input == m_boundInput)
+        return;
+
+    const int64_t inShape[] = { count, 3, m_cfg.inputHeight, m_cfg.inputWidth };
+    const std::size_t inCount = static_cast<std::size_t>(count) * 3
+                              * m_cfg.inputHeight * m_cfg.inputWidth;
+    Ort::Value in = Ort::Value::CreateTensor<float>(m_memInfo, const_cast<float*>(input),
+                                                    inCount, inShape, 4);
+
+    // 输出缓冲只增不减，批变小时复用前段
+    m_outputShape[0] = count;
+    const std::size_t outCount = static_cast<std::size_t>(count)
+                               * m_outputShape[1] * m_outputShape[2];
+    if (m_output.size() < outCount)
+        m_output.resize(outCount);
+    Ort::Value out = Ort::Value::CreateTensor<float>(m_memInfo, m_output.data(), outCount,
+                                                     m_outputShape.data(), m_outputShape.size());
+
+    m_binding->ClearBoundInputs();
+    m_binding->ClearBoundOutputs();
+    m_binding->BindInput(m_inputName.c_str(), in);
+    m_binding->BindOutput(m_outputName.c_str(), out);
+    m_boundCount = count;
+    m_boundInput = input;
+}
+
+bool OnnxRuntimeDetector::run(int count)
+{
+    const auto t0 = cv::getTickCount();
+    try {
+        // 绑定同样可能抛出（张量创建/名称不匹配），异常不得逃出 detect
+        bind(count);
+        m_session->Run(Ort::RunOptions{ nullptr }, *m_binding);
+    } catch (const Ort::Exception&) {
+        m_boundCount = 0;   // 下次调用强制重新绑定
+        return false;
+    }
+    m_lastInfMs = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+    return true;
+}
+
+DetectionList OnnxRuntimeDetector::detect(const cv::Mat& frame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_loaded || frame.empty())
+        return {};
+
+    m_pre.prepare(1);
+    const Letterbox lb = m_pre.fill(0, frame);
+    if (!run(1))
+        return {};
+
+    const cv::Mat pred(static_cast<int>(m_outputShape[1]), static_cast<int>(m_outputShape[2]),
+                       CV_32F, m_output.data());
+    return m_post.run(pred, lb, frame.size(), m_cfg.confThresh, m_cfg.nmsThresh, m_labels);
+}
+
+std::vector<DetectionList> OnnxRuntimeDetector::detectBatch(const std::vector<cv::Mat>& frames)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::vector<DetectionList> results;
+    results.reserve(frames.size());
+    if (!m_loaded) {
+        results.resize(frames.size());
+        return results;
+    }
+    if (!m_dynamicBatch) {
+        lock.unlock();
+        return DetectorBase::detectBatch(frames);
+    }
+
+    const std::size_t maxBatch = static_cast<std::size_t>(std::max(1, m_cfg.maxBatch));
+    const std::size_t perFrame = static_cast<std::size_t>(m_outputShape[1] * m_outputShape[2]);
+    std::vector<Letterbox> boxes;
+    for (std::size_t first = 0; first < frames.size(); first += maxBatch) {
+        const int count = static_cast<int>(std::min(maxBatch, frames.size() - first));
+        m_pre.prepare(count);
+        boxes.assign(static_cast<std::size_t>(count), Letterbox{});
+        for (int i = 0; i < count; ++i)
+            boxes[static_cast<std::size_t>(i)] = m_pre.fill(i, frames[first + i]);
+
+        const bool ok = run(count);
+        for (int i = 0; i < count; ++i) {
+            const cv::Mat& f = frames[first + i];
+            if (!ok || f.empty()) {
+                results.emplace_back();
+                continue;
+            }
+            const cv::Mat pred(static_cast<int>(m_outputShape[1]), static_cast<int>(m_outputShape[2]),
+                               CV_32F, m_output.data() + perFrame * i);
+            results.push_back(m_post.run(pred, boxes[static_cast<std::size_t>(i)], f.size(),
+                                         m_cfg.confThresh, m_cfg.nmsThresh, m_labels));
+        }
+    }
+    return results;
+}
+
+bool OnnxRuntimeDetector::isLoaded() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_loaded;
+}
+
+void OnnxRuntimeDetector::setConfThreshold(float t)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg.confThresh = std::clamp(t, 0.0f, 1.0f);
+}
+
+float OnnxRuntimeDetector::confThreshold() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg.confThresh;
+}
+
+void OnnxRuntimeDetector::setNmsThreshold(float t)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg.nmsThresh = std::clamp(t, 0.0f, 1.0f);
+}
+
+float OnnxRuntimeDetector::nmsThreshold() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg.nmsThresh;
+}
+
+void OnnxRuntimeDetector::setConfig(OrtConfig cfg)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg = cfg;
+}
+
+OrtConfig OnnxRuntimeDetector::config() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg;
+}
+
+double OnnxRuntimeDetector::lastInferenceMsec() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastInfMs;
+}
+
+std::string OnnxRuntimeDetector::loadedModelPath() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_modelPath;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "DetectorBase.h"
+#include "LabelMap.h"
+#include "YoloPreprocess.h"
+#include "YoloPostprocess.h"
+#include <onnxruntime_cxx_api.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 模型精度：Int8 时优先加载同目录下的量化模型（<名称>_int8.onnx），不存在则用原路径
+enum class OrtPrecision { FP32, Int8 };
+
+struct OrtConfig {
+    int          inputWidth     = 640;
+    int          inputHeight    = 640;
+    float        confThresh     = 0.50f;
+    float        nmsThresh      = 0.45f;
+    int          intraOpThreads = 0;       // 0 = ONNX Runtime 默认（物理核数）
+    // intra-op 线程的绑核（逻辑核编号，如 DetectorPool 分配的核子集）：ORT 不绑定调用线程，
+    // 其余 intraOpThreads - 1 个线程依次绑定 intraOpCores[1..]；为空或核数不足时不绑定
+    std::vector<int> intraOpCores;
+    int          interOpThreads = 1;       // 仅 parallelExecution 时生效
+    bool         parallelExecution = false;
+    OrtPrecision precision      = OrtPrecision::FP32;
+    int          maxBatch       = 8;
+};
+
+// 基于 ONNX Runtime（CPU EP）的 YOLOv8 检测引擎，与 YOLODetector 共用前/后处理。
+// 输入张量直接绑定到 YoloPreprocessor 的常驻缓冲区，输出绑定到预分配缓冲区，
+// 稳态推理不产生 ONNX Runtime 侧的张量分配
+class OnnxRuntimeDetector : public DetectorBase {
+public:
+    explicit OnnxRuntimeDetector(OrtConfig cfg = {});
+    ~OnnxRuntimeDetector() override;
+
+    // 线程数与精度在加载时生效
+    bool loadModel(const std::string& modelPath,
+                   const std::string& labelsPath = "") override;
+    DetectionList detect(const cv::Mat& frame) override;
+    std::vector<DetectionList> detectBatch(const std::vector<cv::Mat>& frames) override;
+    bool  isLoaded()        const override;
+    void  setConfThreshold(float t) override;
+    float confThreshold()  const override;
+    void  setNmsThreshold(float t) override;
+    float nmsThreshold()   const override;
+
+    void      setConfig(OrtConfig cfg);     // 需重新 loadModel
+    OrtConfig config() const;
+
+    double lastInferenceMsec() const;
+    std::string loadedModelPath() const;    // 实际加载的模型文件（精度选择后）
+
+    const LabelMap& labels() const { return m_labels; }
+
+private:
+    static std::string resolveModelPath(const std::string& path, OrtPrecision precision);
+
+    // 对预处理器中前 count 个批槽执行一次推理（调用方持有 m_mutex）
+    bool run(int count);
+    // 按 count 重新绑定输入/输出（批大小或缓冲区地址变化时）
+    void bind(int count);
+
+    OrtConfig        m_cfg;
+    LabelMap         m_labels;
+    mutable std::mutex m_mutex;
+    bool             m_loaded = false;
+    double           m_lastInfMs = 0.0;
+    std::string      m_modelPath;
+
+    Ort::Env                      m_env;
+    std::unique_ptr<Ort::Session> m_session;
+    std::unique_ptr<Ort::IoBinding> m_binding;
+    Ort::MemoryInfo               m_memInfo;
+    std::string                   m_inputName;
+    std::string                   m_outputName;
+    std::vector<int64_t>          m_outputShape;   // [N, 4 + C, anchors]，批维随调用设置；C 为动态时取类别表大小
+    bool                          m_dynamicBatch = false;
+
+    YoloPreprocessor  m_pre;
+    YoloPostprocessor m_post;
+    std::vector<float> m_output;                   // 输出缓冲（按最大批容量分配）
+    int               m_boundCount = 0;
+    const float*      m_boundInput = nullptr;
+};
@@ -0,0 +1,253 @@
+#include "SortTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <tuple>
+
+namespace {
+constexpr int kStateDim = 7;
+constexpr int kMeasDim  = 4;
+
+cv::Mat diagonal(std::initializer_list<float> values)
+{
+    const int n = static_cast<int>(values.size());
+    cv::Mat m = cv::Mat::zeros(n, n, CV_32F);
+    int i = 0;
+    for (float v : values) {
+        m.at<float>(i, i) = v;
+        ++i;
+    }
+    return m;
+}
+
+} // namespace
+
+SortTracker::SortTracker(TrackerConfig cfg)
+    : m_cfg(cfg)
+{}
+
+void SortTracker::reset()
+{
+    m_tracks.clear();
+    m_nextId  = 1;
+    m_updates = 0;
+}
+
+cv::Mat SortTracker::toMeasurement(const cv::Rect2f& box)
+{
+    cv::Mat z(kMeasDim, 1, CV_32F);
+    z.at<float>(0) = box.x + box.width  * 0.5f;
+    z.at<float>(1) = box.y + box.height * 0.5f;
+    z.at<float>(2) = box.width * box.height;
+    z.at<float>(3) = box.width / std::max(box.height, 1e-3f);
+    return z;
+}
+
+cv::Rect2f SortTracker::toBox(float cx, float cy, float s, float r)
+{
+    const float w = std::sqrt(std::max(s * r, 0.0f));
+    const float h = w > 0.0f ? s / w : 0.0f;
+    return { cx - w * 0.5f, cy - h * 0.5f, w, h };
+}
+
+cv::Rect2f SortTracker::boxOf(const Track& t, double dt)
+{
+    const cv::Mat& x = t.kf.statePost;
+    const float d  = static_cast<float>(dt);
+    const float s  = std::max(x.at<float>(2) + x.at<float>(6) * d, 1.0f);
+    return toBox(x.at<float>(0) + x.at<float>(4) * d,
+                 x.at<float>(1) + x.at<float>(5) * d, s, x.at<float>(3));
+}
+
+float SortTracker::iou(const cv::Rect2f& a, const cv::Rect2f& b)
+{
+    const float inter = (a & b).area();
+    const float uni   = a.area() + b.area() - inter;
+    return uni > 0.0f ? inter / uni : 0.0f;
+}
+
+SortTracker::Track SortTracker::newTrack(const Detection& d, std::uint64_t frameId)
+{
+    Track t;
+    t.kf.init(kStateDim, kMeasDim, 0, CV_32F);
+
+    // 与 SORT 原实现相同的噪声设定
+    cv::setIdentity(t.kf.transitionMatrix);
+    t.kf.measurementMatrix = cv::Mat::zeros(kMeasDim, kStateDim, CV_32F);
+    for (int i = 0; i < kMeasDim; ++i)
+        t.kf.measurementMatrix.at<float>(i, i) = 1.0f;
+
+    t.kf.measurementNoiseCov = diagonal({ 1, 1, 10, 10 });
+    t.kf.processNoiseCov     = diagonal({ 1, 1, 1, 1, 0.01f, 0.01f, 1e-4f });
+    t.kf.errorCovPost        = diagonal({ 10, 10, 10, 10, 1e4f, 1e4f, 1e4f });
+
+    t.kf.statePost = cv::Mat::zeros(kStateDim, 1, CV_32F);
+    toMeasurement(d.bbox).copyTo(t.kf.statePost.rowRange(0, kMeasDim));
+
+    t.id         = m_nextId++;
+    t.classId    = d.classId;
+    t.confidence = d.confidence;
+    t.label      = d.label;
+    t.hits       = 1;
+    t.frame      = frameId;
+    t.lastMatch  = frameId;
+    return t;
+}
+
+bool SortTracker::expired(const Track& t, std::uint64_t frameId) const
+{
+    return frameId > t.lastMatch + static_cast<std::uint64_t>(std::max(m_cfg.maxAge, 0));
+}
+
+void SortTracker::predictTo(Track& t, std::uint64_t frameId) const
+{
+    if (frameId <= t.frame)
+        return;
+    const float dt = static_cast<float>(frameId - t.frame);
+
+    // 面积将变为负值时清零面积速度
+    cv::Mat& x = t.kf.statePost;
+    if (x.at<float>(2) + x.at<float>(6) * dt <= 0.0f)
+        x.at<float>(6) = 0.0f;
+
+    // 多帧一步外推：F 的速度项取 dt，过程噪声按 dt 放大
+    for (int i = 0; i < 3; ++i)
+        t.kf.transitionMatrix.at<float>(i, i + 4) = dt;
+    const cv::Mat q = t.kf.processNoiseCov.clone();
+    t.kf.processNoiseCov = q * dt;
+    t.kf.predict();
+    t.kf.processNoiseCov = q;
+    t.frame = frameId;
+}
+
+void SortTracker::holdAt(Track& t, std::uint64_t frameId)
+{
+    cv::Mat& x = t.kf.statePost;
+    for (int i = kMeasDim; i < kStateDim; ++i)
+        x.at<float>(i) = 0.0f;
+    t.frame     = std::max(t.frame, frameId);
+    t.lastMatch = t.frame;
+}
+
+DetectionList SortTracker::update(const DetectionList& detections,
+                                  std::uint64_t detFrameId, std::uint64_t nowFrameId,
+                                  const std::vector<cv::Rect>& coverage)
+{
+    ++m_updates;
+    nowFrameId = std::max(nowFrameId, detFrameId);
+
+    // 长期未匹配的轨迹已停止外推，其状态与当前帧脱节，不参与关联
+    m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(),
+                                  [&](const Track& t) { return expired(t, nowFrameId); }),
+                   m_tracks.end());
+    for (Track& t : m_tracks)
+        predictTo(t, nowFrameId);
+
+    // 1. 关联：轨迹回推到检测来源帧后与检测框求 IoU（仅同类别），按 IoU 降序贪心匹配
+    const double lag = static_cast<double>(nowFrameId - detFrameId);
+    std::vector<std::tuple<float, std::size_t, std::size_t>> pairs;   // (iou, track, det)
+    for (std::size_t ti = 0; ti < m_tracks.size(); ++ti) {
+        const cv::Rect2f tb = boxOf(m_tracks[ti], -lag);
+        for (std::size_t di = 0; di < detections.size(); ++di) {
+            if (detections[di].classId != m_tracks[ti].classId)
+                continue;
+            const float v = iou(tb, detections[di].bbox);
+            if (v >= m_cfg.iouThreshold)
+                pairs.emplace_back(v, ti, di);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(),
+              [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+
+    std::vector<bool> trackMatched(m_tracks.size(), false);
+    std::vector<bool> detMatched(detections.size(), false);
+    for (const auto& [v, ti, di] : pairs) {
+        if (trackMatched[ti] || detMatched[di])
+            continue;
+        trackMatched[ti] = true;
+        detMatched[di]   = true;
+
+        // 2. 修正：量测按轨迹速度前推 lag 帧，作为当前帧的观测
+        Track& t = m_tracks[ti];
+        cv::Mat z = toMeasurement(detections[di].bbox);
+        const cv::Mat& x = t.kf.statePost;
+        const float l = static_cast<float>(lag);
+        z.at<float>(0) += x.at<float>(4) * l;
+        z.at<float>(1) += x.at<float>(5) * l;
+        z.at<float>(2)  = std::max(z.at<float>(2) + x.at<float>(6) * l, 1.0f);
+        t.kf.correct(z);
+
+        t.confidence = detections[di].confidence;
+        t.label      = detections[di].label;
+        ++t.hits;
+        t.misses    = 0;
+        t.lastMatch = nowFrameId;
+    }
+
+    // 3. 未匹配轨迹累计丢失，超限删除；未匹配检测新建轨迹（状态取其来源帧后外推）
+    const auto observed = [&](const Track& t) {
+        if (coverage.empty())
+            return true;
+        const cv::Rect2f b = boxOf(t, -lag);
+        const cv::Point2f c(b.x + b.width * 0.5f, b.y + b.height * 0.5f);
+        for (const cv::Rect& r : coverage)
+            if (cv::Rect2f(r).contains(c))
+                return true;
+        return false;
+    };
+    for (std::size_t ti = 0; ti < m_tracks.size(); ++ti) {
+        if (trackMatched[ti])
+            continue;
+        if (observed(m_tracks[ti]))
+            ++m_tracks[ti].misses;
+        else
+            holdAt(m_tracks[ti], nowFrameId);   // 区域外无运动：目标静止于原处
+    }
+    m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(),
+                                  [this](const Track& t) { return t.misses > m_cfg.maxMisses; }),
+                   m_tracks.end());
+
+    for (std::size_t di = 0; di < detections.size(); ++di) {
+        if (detMatched[di])
+            continue;
+        m_tracks.push_back(newTrack(detections[di], detFrameId));
+        predictTo(m_tracks.back(), nowFrameId);
+    }
+
+    return output(nowFrameId);
+}
+
+DetectionList SortTracker::predict(std::uint64_t nowFrameId)
+{
+    // 恒速外推误差随帧数累积：超过 maxAge 后停在最后位置，由 output() 隐藏
+    const auto maxAge = static_cast<std::uint64_t>(std::max(m_cfg.maxAge, 0));
+    for (Track& t : m_tracks)
+        predictTo(t, std::min(nowFrameId, t.lastMatch + maxAge));
+    return output(nowFrameId);
+}
+
+DetectionList SortTracker::hold(std::uint64_t nowFrameId)
+{
+    for (Track& t : m_tracks)
+        holdAt(t, nowFrameId);
+    return output(nowFrameId);
+}
+
+DetectionList SortTracker::output(std::uint64_t nowFrameId) const
+{
+    // 仅输出最近一次更新中匹配到且未过期的已确认轨迹；启动阶段允许未确认轨迹输出
+    const bool warmup = m_updates <= m_cfg.minHits;
+    DetectionList out;
+    for (const Track& t : m_tracks) {
+        if (t.misses > 0 || (t.hits < m_cfg.minHits && !warmup) || expired(t, nowFrameId))
+            continue;
+        Detection d;
+        d.bbox       = boxOf(t, 0.0);
+        d.classId    = t.classId;
+        d.confidence = t.confidence;
+        d.label      = t.label;
+        d.trackId    = t.id;
+        out.push_back(std::move(d));
+    }
+    return out;
+}
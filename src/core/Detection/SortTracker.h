@@ -0,0 +1,71 @@
+#pragma once
+#include "Detection.h"
+#include <opencv2/video.hpp>
+#include <cstdint>
+#include <vector>
+
+struct TrackerConfig {
+    float iouThreshold = 0.3f;   // 关联所需的最小 IoU
+    int   minHits      = 2;      // 匹配达到该次数后才输出（启动阶段除外）
+    int   maxMisses    = 2;      // 连续该次数的检测更新未匹配则删除轨迹
+    int   maxAge       = 60;     // 距上次匹配超过该帧数：停止外推并隐藏，下次检测更新时删除（应大于检测间隔）
+};
+
+// SORT 风格多目标跟踪：恒速卡尔曼预测 + IoU 贪心关联，
+// 在两次推理之间逐帧外推检测框，并为每个目标分配稳定的 trackId
+//
+// 时间以帧编号计：检测结果来自较早的帧 F、当前帧为 N 时，
+// 关联使用轨迹回推到 F 的位置，量测按轨迹速度前推到 N 后再修正（延迟补偿）
+class SortTracker {
+public:
+    explicit SortTracker(TrackerConfig cfg = {});
+
+    void setConfig(TrackerConfig cfg) { m_cfg = cfg; }
+    TrackerConfig config() const { return m_cfg; }
+
+    // 新检测结果到达：detFrameId 为其来源帧，nowFrameId 为当前帧；返回当前帧的已确认轨迹
+    // coverage 非空时仅检测了这些区域：中心不在其中的轨迹所在处无运动，原地保持且不计丢失
+    DetectionList update(const DetectionList& detections,
+                         std::uint64_t detFrameId, std::uint64_t nowFrameId,
+                         const std::vector<cv::Rect>& coverage = {});
+
+    // 无新结果的帧：仅预测到 nowFrameId；超过 maxAge 的轨迹停在原位且不输出
+    DetectionList predict(std::uint64_t nowFrameId);
+
+    // 画面静止（运动门控未检测到变化）的帧：轨迹原地保持、速度清零，并视为已观测（不过期）
+    DetectionList hold(std::uint64_t nowFrameId);
+
+    void reset();
+
+    std::size_t trackCount() const { return m_tracks.size(); }
+
+private:
+    // 状态 [cx, cy, s, r, vx, vy, vs]（s = 面积，r = 宽高比，速度单位为每帧），量测 [cx, cy, s, r]
+    struct Track {
+        cv::KalmanFilter kf;
+        int              id         = 0;
+        int              classId    = 0;
+        float            confidence = 0.0f;
+        std::string      label;
+        int              hits       = 0;
+        int              misses     = 0;
+        std::uint64_t    frame      = 0;   // kf 状态对应的帧编号
+        std::uint64_t    lastMatch  = 0;   // 最近一次被检测修正（或新建）的帧编号
+    };
+
+    static cv::Mat    toMeasurement(const cv::Rect2f& box);
+    static cv::Rect2f toBox(float cx, float cy, float s, float r);
+    static cv::Rect2f boxOf(const Track& t, double dt);   // 以当前状态外推 dt 帧
+    static float      iou(const cv::Rect2f& a, const cv::Rect2f& b);
+
+    Track newTrack(const Detection& d, std::uint64_t frameId);
+    void  predictTo(Track& t, std::uint64_t frameId) const;
+    static void holdAt(Track& t, std::uint64_t frameId);
+    bool  expired(const Track& t, std::uint64_t frameId) const;
+    DetectionList output(std::uint64_t nowFrameId) const;
+
+    TrackerConfig      m_cfg;
+    std::vector<Track> m_tracks;
+    int                m_nextId  = 1;
+    int                m_updates = 0;   // 已处理的检测更新次数
+};
@@ -0,0 +1,156 @@
+#include "TiledDetector.h"
+#include <algorithm>
+#include <cmath>
+
+TiledDetector::TiledDetector(DetectorBase& inner, TileConfig cfg)
+    : m_inner(&inner)
+    , m_cfg(cfg)
+{}
+
+void TiledDetector::setConfig(TileConfig cfg)
+{
+    cfg.tileSize.width  = std::max(32, cfg.tileSize.width);
+    cfg.tileSize.height = std::max(32, cfg.tileSize.height);
+    cfg.overlap         = std::clamp(cfg.overlap, 0.0, 0.9);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg = cfg;
+}
+
+TileConfig TiledDetector::config() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg;
+}
+
+std::vector<cv::Rect> TiledDetector::tilesFor(const cv::Size& frameSize) const
+{
+    return tileGrid(frameSize, config());
+}
+
+bool TiledDetector::loadModel(const std::string& modelPath, const std::string& labelsPath)
+{
+    return m_inner.load()->loadModel(modelPath, labelsPath);
+}
+
+std::vector<int> TiledDetector::axisOffsets(int length, int tile, double overlap)
+{
+    if (length <= tile)
+        return {0};
+
+    // 切片数取满足最小重叠的最少值，起点均匀分布使末片恰好贴齐边缘
+    const double stride = tile * (1.0 - overlap);
+    const int    n      = static_cast<int>(std::ceil((length - tile) / stride)) + 1;
+    std::vector<int> offsets(static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i)
+        offsets[static_cast<std::size_t>(i)] =
+            static_cast<int>(std::lround(static_cast<double>(i) * (length - tile) / (n - 1)));
+    return offsets;
+}
+
+std::vector<cv::Rect> TiledDetector::tileGrid(const cv::Size& frameSize, const TileConfig& cfg)
+{
+    const int tw = std::min(cfg.tileSize.width, frameSize.width);
+    const int th = std::min(cfg.tileSize.height, frameSize.height);
+
+    std::vector<cv::Rect> tiles;
+    for (int y : axisOffsets(frameSize.height, th, cfg.overlap))
+        for (int x : axisOffsets(frameSize.width, tw, cfg.overlap))
+            tiles.emplace_back(x, y, tw, th);
+    return tiles;
+}
+
+DetectionList TiledDetector::detect(const cv::Mat& frame)
+{
+    return detectBatch({frame}).front();
+}
+
+std::vector<DetectionList> TiledDetector::detectBatch(const std::vector<cv::Mat>& frames)
+{
+    const TileConfig cfg = config();
+    if (!cfg.enabled)
+        return m_inner.load()->detectBatch(frames);
+
+    // 所有帧的切片（及整帧）合并为一次 detectBatch；单片即可覆盖的帧直接整帧推理
+    struct Slot {
+        std::size_t frame;
+        cv::Rect    rect;
+        int         source;
+    };
+    std::vector<cv::Mat> crops;
+    std::vector<Slot>    slots;
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        const cv::Mat& frame = frames[f];
+        const cv::Rect full(0, 0, frame.cols, frame.rows);
+        const std::vector<cv::Rect> tiles = frame.empty()
+            ? std::vector<cv::Rect>{} : tileGrid(frame.size(), cfg);
+
+        if (tiles.size() <= 1) {
+            crops.push_back(frame);
+            slots.push_back({f, full, -1});
+            continue;
+        }
+        for (std::size_t t = 0; t < tiles.size(); ++t) {
+            crops.push_back(frame(tiles[t]));
+            slots.push_back({f, tiles[t], static_cast<int>(t)});
+        }
+        if (cfg.fullFrame) {
+            crops.push_back(frame);
+            slots.push_back({f, full, -1});
+        }
+    }
+
+    const std::vector<DetectionList> perCrop = m_inner.load()->detectBatch(crops);
+
+    std::vector<std::vector<Tagged>> perFrame(frames.size());
+    for (std::size_t i = 0; i < perCrop.size() && i < slots.size(); ++i) {
+        const Slot& s = slots[i];
+        for (Detection d : perCrop[i]) {
+            d.bbox.x += static_cast<float>(s.rect.x);
+            d.bbox.y += static_cast<float>(s.rect.y);
+            perFrame[s.frame].push_back({std::move(d), s.source});
+        }
+    }
+
+    std::vector<DetectionList> results;
+    results.reserve(frames.size());
+    for (auto& dets : perFrame)
+        results.push_back(merge(dets, cfg.mergeIos));
+    return results;
+}
+
+DetectionList TiledDetector::merge(std::vector<Tagged>& dets, float mergeIos)
+{
+    // 同一来源内的重复框已由内部检测器的 NMS 去除，这里只处理跨切片边界的同一目标：
+    // 被切片截断的框面积小、与完整框的 IoU 偏低，故以交集 / 较小框面积判定
+    std::stable_sort(dets.begin(), dets.end(), [](const Tagged& a, const Tagged& b) {
+        return a.det.confidence > b.det.confidence;
+    });
+
+    std::vector<bool> absorbed(dets.size(), false);
+    DetectionList out;
+    for (std::size_t i = 0; i < dets.size(); ++i) {
+        if (absorbed[i])
+            continue;
+        Detection        keep = dets[i].det;
+        // 已并入 keep 的来源，同一来源的两个框视为不同目标
+        std::vector<int> sources{dets[i].source};
+
+        for (std::size_t j = i + 1; j < dets.size(); ++j) {
+            const Tagged& other = dets[j];
+            if (absorbed[j] || other.det.classId != keep.classId
+                || std::find(sources.begin(), sources.end(), other.source) != sources.end())
+                continue;
+
+            const float inter   = (keep.bbox & other.det.bbox).area();
+            const float smaller = std::min(keep.bbox.area(), other.det.bbox.area());
+            if (smaller <= 0.0f || inter / smaller < mergeIos)
+                continue;
+
+            // 保留最高置信度框本身：取并集会把相邻的同类目标或截断框的外沿一并吞入，使框膨胀
+            sources.push_back(other.source);
+            absorbed[j] = true;
+        }
+        out.push_back(std::move(keep));
+    }
+    return out;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "DetectorBase.h"
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+struct TileConfig {
+    bool     enabled   = false;      // false 时直接转发给内部检测器
+    cv::Size tileSize  {640, 640};   // 源像素；取网络输入尺寸时切片无需缩放
+    double   overlap   = 0.2;        // 相邻切片的最小重叠比例
+    bool     fullFrame = true;       // 追加一次整帧推理，覆盖跨多片的大目标
+    float    mergeIos  = 0.5f;       // 跨切片合并阈值：交集 / 较小框面积
+};
+
+// 切片推理：将高分辨率帧切成带重叠的网络尺寸切片，连同（可选）整帧一起
+// 以一次 detectBatch 提交给内部检测器，框映射回整帧后跨切片合并。
+// 内部检测器为 YOLODetector 时切片在同一批前向中完成，为 DetectorPool 时在多实例间并行
+class TiledDetector : public DetectorBase {
+public:
+    explicit TiledDetector(DetectorBase& inner, TileConfig cfg = {});
+
+    // 切换内部检测器（推理引擎切换时）；inner 须在本对象生命周期内有效
+    void       setInner(DetectorBase& inner) { m_inner = &inner; }
+    DetectorBase& inner() const             { return *m_inner; }
+
+    void       setConfig(TileConfig cfg);
+    TileConfig config() const;
+
+    // 给定帧尺寸的切片网格（不含整帧），用于估算单帧推理开销
+    std::vector<cv::Rect> tilesFor(const cv::Size& frameSize) const;
+
+    // ──── DetectorBase ────
+    bool loadModel(const std::string& modelPath, const std::string& labelsPath = "") override;
+    DetectionList detect(const cv::Mat& frame) override;
+    std::vector<DetectionList> detectBatch(const std::vector<cv::Mat>& frames) override;
+    bool  isLoaded() const override                { return m_inner.load()->isLoaded(); }
+    void  setConfThreshold(float t) override       { m_inner.load()->setConfThreshold(t); }
+    float confThreshold() const override           { return m_inner.load()->confThreshold(); }
+    void  setNmsThreshold(float t) override        { m_inner.load()->setNmsThreshold(t); }
+    float nmsThreshold() const override            { return m_inner.load()->nmsThreshold(); }
+
+private:
+    struct Tagged {
+        Detection det;
+        int       source;   // 切片下标（整帧为 -1）
+    };
+
+    static std::vector<cv::Rect> tileGrid(const cv::Size& frameSize, const TileConfig& cfg);
+    static std::vector<int>      axisOffsets(int length, int tile, double overlap);
+    // 按置信度降序贪心合并：不同来源、同类且 IoS ≥ 阈值的框被较高置信度框吸收（保留其原框）
+    static DetectionList         merge(std::vector<Tagged>& dets, float mergeIos);
+
+    std::atomic<DetectorBase*> m_inner;   // 检测线程读取，帧线程切换
+    mutable std::mutex m_mutex;
+    TileConfig         m_cfg;
+};
@@ -0,0 +1,307 @@
+#include "YOLODetector.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+YOLODetector::YOLODetector(YOLOConfig cfg)
+    : m_cfg(cfg)
+    , m_inputSize(cfg.inputWidth, cfg.inputHeight)
+    , m_pre(m_inputSize)
+{
+    m_labels.loadCOCO80();
+}
+
+namespace {
+
+double msecSince(int64 t0)
+{
+    return (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+}
+
+} // namespace
+
+bool YOLODetector::loadModel(const std::string& modelPath, const std::string& labelsPath)
+{
+    PreparedModel model;
+    if (!prepareModel(modelPath, labelsPath, model))
+        return false;
+    install(std::move(model));
+    return true;
+}
+
+bool YOLODetector::prepareModel(const std::string& modelPath, const std::string& labelsPath,
+                                PreparedModel& out) const
+{
+    YOLOConfig cfg;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cfg = m_cfg;
+    }
+    return prepare(modelPath, labelsPath, cfg, out);
+}
+
+bool YOLODetector::prepare(const std::string& modelPath, const std::string& labelsPath,
+                           const YOLOConfig& cfg, PreparedModel& out)
+{
+    const cv::Size inputSize(cfg.inputWidth, cfg.inputHeight);
+    out.key   = NetKey::make(modelPath, cfg.backendId, cfg.targetId, inputSize);
+    out.stats = ModelLoadStats{};
+
+    const auto t0 = cv::getTickCount();
+    if (cfg.cacheNetworks && NetCache::instance().take(out.key, out.net)) {
+        out.stats.fromCache = true;
+        out.stats.loadMsec  = msecSince(t0);
+    } else {
+        try {
+            out.net = cv::dnn::readNetFromONNX(modelPath);
+        } catch (const cv::Exception&) {
+            return false;
+        }
+        if (out.net.empty())
+            return false;
+        out.net.setPreferableBackend(cfg.backendId);
+        out.net.setPreferableTarget(cfg.targetId);
+        out.stats.loadMsec = msecSince(t0);
+
+        // 首次 forward 承担层初始化与内存规划，在生效前完成
+        try {
+            out.stats.warmupMsec = warmUp(out.net, inputSize, cfg.warmupRuns);
+        } catch (const cv::Exception&) {
+            return false;   // 模型与输入尺寸不匹配等
+        }
+    }
+
+    out.labelsPath = labelsPath;
+    if (labelsPath.empty() || !out.labels.loadFromFile(labelsPath))
+        out.labels.loadCOCO80();
+    return true;
+}
+
+double YOLODetector::warmUp(cv::dnn::Net& net, const cv::Size& inputSize, int runs)
+{
+    if (runs <= 0)
+        return 0.0;
+
+    const auto t0 = cv::getTickCount();
+    const int shape[] = {1, 3, inputSize.height, inputSize.width};
+    const cv::Mat blob(4, shape, CV_32F, cv::Scalar(114.0 / 255.0));
+    const std::vector<std::string> names = net.getUnconnectedOutLayersNames();
+    std::vector<cv::Mat> outputs;
+    for (int i = 0; i < runs; ++i) {
+        net.setInput(blob);
+        net.forward(outputs, names);
+    }
+    return msecSince(t0);
+}
+
+void YOLODetector::install(PreparedModel&& model)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    installLocked(std::move(model));
+}
+
+bool YOLODetector::tryInstall(PreparedModel& model)
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+        return false;
+    installLocked(std::move(model));
+    return true;
+}
+
+void YOLODetector::recycle(PreparedModel&& model)
+{
+    // cacheNetworks 仅在构造时设定，无需持锁（不在推理之后等待）
+    if (m_cfg.cacheNetworks && !model.net.empty())
+        NetCache::instance().put(model.key, model.net);
+}
+
+void YOLODetector::installLocked(PreparedModel&& model)
+{
+    if (m_loaded && m_cfg.cacheNetworks)
+        NetCache::instance().put(m_key, m_net);
+
+    m_net        = std::move(model.net);
+    m_key        = std::move(model.key);
+    m_labels     = std::move(model.labels);
+    m_labelsPath = std::move(model.labelsPath);
+    m_loadStats  = model.stats;
+    m_fixedBatch = false;
+    m_loaded     = true;
+}
+
+ModelLoadStats YOLODetector::lastLoadStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_loadStats;
+}
+
+DetectionList YOLODetector::detect(const cv::Mat& frame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_loaded || frame.empty())
+        return {};
+
+    Letterbox lb;
+    const cv::Mat& blob = m_pre.run(frame, lb);
+
+    const auto t0 = cv::getTickCount();
+    std::vector<cv::Mat> outputs;
+    try {
+        m_net.setInput(blob);
+        m_net.forward(outputs, m_net.getUnconnectedOutLayersNames());
+    } catch (const cv::Exception&) {
+        outputs.clear();
+    }
+    m_lastInfMs = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+
+    if (outputs.empty() || outputs[0].dims != 3)
+        return {};
+    const cv::Mat& out = outputs[0];
+    const cv::Mat pred(out.size[1], out.size[2], CV_32F, const_cast<float*>(out.ptr<float>()));
+    return postprocess(pred, lb, frame.size());
+}
+
+std::vector<DetectionList> YOLODetector::detectBatch(const std::vector<cv::Mat>& frames)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::vector<DetectionList> results;
+    results.reserve(frames.size());
+    if (!m_loaded) {
+        results.resize(frames.size());
+        return results;
+    }
+
+    const std::size_t maxBatch = static_cast<std::size_t>(std::max(1, m_cfg.maxBatch));
+    std::size_t first = 0;
+    while (first < frames.size() && !m_fixedBatch) {
+        const std::size_t count = std::min(maxBatch, frames.size() - first);
+        if (!forwardBatch(frames, first, count, results))
+            break;
+        first += count;
+    }
+    lock.unlock();
+
+    // 固定批维模型：剩余帧逐帧推理
+    for (; first < frames.size(); ++first)
+        results.push_back(detect(frames[first]));
+    return results;
+}
+
+bool YOLODetector::forwardBatch(const std::vector<cv::Mat>& frames, std::size_t first,
+                                std::size_t count, std::vector<DetectionList>& results)
+{
+    // 各帧直接写入常驻 NCHW 张量的对应批槽；空帧写入填充色，保持下标与 frames 对齐
+    const cv::Mat& blob = m_pre.prepare(static_cast<int>(count));
+    std::vector<Letterbox> boxes(count);
+    for (std::size_t i = 0; i < count; ++i)
+        boxes[i] = m_pre.fill(static_cast<int>(i), frames[first + i]);
+
+    // 一次前向
+    std::vector<cv::Mat> outputs;
+    const auto t0 = cv::getTickCount();
+    try {
+        m_net.setInput(blob);
+        m_net.forward(outputs, m_net.getUnconnectedOutLayersNames());
+    } catch (const cv::Exception&) {
+        outputs.clear();
+    }
+    m_lastInfMs = (cv::getTickCount() - t0) * 1000.0 / cv::getTickFrequency();
+
+    if (outputs.empty() || outputs[0].dims != 3 || outputs[0].size[0] != static_cast<int>(count)) {
+        if (count > 1)
+            m_fixedBatch = true;
+        return false;
+    }
+
+    // 输出 [N, 4 + numClasses, numAnchors]，按批下标切出每帧的二维视图
+    const cv::Mat& out = outputs[0];
+    for (std::size_t i = 0; i < count; ++i) {
+        const cv::Mat& f = frames[first + i];
+        if (f.empty()) {
+            results.emplace_back();
+            continue;
+        }
+        const cv::Mat pred(out.size[1], out.size[2], CV_32F,
+                           const_cast<float*>(out.ptr<float>(static_cast<int>(i))));
+        results.push_back(postprocess(pred, boxes[i], f.size()));
+    }
+    return true;
+}
+
+bool YOLODetector::isLoaded() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_loaded;
+}
+
+void YOLODetector::setConfThreshold(float t)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg.confThresh = std::clamp(t, 0.0f, 1.0f);
+}
+
+float YOLODetector::confThreshold() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg.confThresh;
+}
+
+void YOLODetector::setNmsThreshold(float t)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg.nmsThresh = std::clamp(t, 0.0f, 1.0f);
+}
+
+float YOLODetector::nmsThreshold() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg.nmsThresh;
+}
+
+bool YOLODetector::setBackend(int backendId, int targetId)
+{
+    YOLOConfig cfg;
+    std::string modelPath, labelsPath;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cfg.backendId = backendId;
+        m_cfg.targetId  = targetId;
+        if (!m_loaded)
+            return true;
+        cfg        = m_cfg;
+        modelPath  = m_key.path;
+        labelsPath = m_labelsPath;
+    }
+
+    // 直接改 preferable 后端会让下一次 forward 重新初始化网络；改为预热好再替换
+    PreparedModel model;
+    if (!prepare(modelPath, labelsPath, cfg, model))
+        return false;
+    install(std::move(model));
+    return true;
+}
+
+double YOLODetector::lastInferenceMsec() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastInfMs;
+}
+
+void YOLODetector::setMaxBatch(int n)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cfg.maxBatch = std::max(1, n);
+}
+
+int YOLODetector::maxBatch() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cfg.maxBatch;
+}
+
+DetectionList YOLODetector::postprocess(const cv::Mat& pred, const Letterbox& lb,
+                                        const cv::Size& origSize)
+{
+    // pred 为原生布局 [4 + numClasses, numAnchors]，无需转置
+    return m_post.run(pred, lb, origSize, m_cfg.confThresh, m_cfg.nmsThresh, m_labels);
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include "DetectorBase.h"
 #include "LabelMap.h"
+#include "YoloPreprocess.h"
+#include "YoloPostprocess.h"
+#include "NetCache.h"
 #include <opencv2/dnn.hpp>
 #include <mutex>
 
@@ -11,6 +14,24 @@ struct YOLOConfig {
     float  nmsThresh    = 0.45f;
     int    backendId    = cv::dnn::DNN_BACKEND_DEFAULT; // CUDA=cv::dnn::DNN_BACKEND_CUDA
     int    targetId     = cv::dnn::DNN_TARGET_CPU;      // CUDA=DNN_TARGET_CUDA
+    int    maxBatch     = 8;    // detectBatch 单次前向的最大帧数
+    int    warmupRuns   = 2;    // 加载后以输入尺寸空跑的次数（完成层初始化与内存规划）
+    bool   cacheNetworks = true; // 切换模型/后端时旧网络归还 NetCache，切回时免加载
+};
+
+struct ModelLoadStats {
+    double loadMsec   = 0.0;   // 读取 ONNX（缓存命中时为取出耗时）
+    double warmupMsec = 0.0;
+    bool   fromCache  = false;
+};
+
+// 已完成读取与预热、尚未生效的模型
+struct PreparedModel {
+    NetKey         key;
+    cv::dnn::Net   net;
+    LabelMap       labels;
+    std::string    labelsPath;
+    ModelLoadStats stats;
 };
 
 class YOLODetector : public DetectorBase {
@@ -20,29 +41,62 @@ public:
     bool loadModel(const std::string& modelPath,
                    const std::string& labelsPath = "") override;
     DetectionList detect(const cv::Mat& frame)    override;
+    std::vector<DetectionList> detectBatch(const std::vector<cv::Mat>& frames) override;
     bool  isLoaded()        const override;
     void  setConfThreshold(float t) override;
     float confThreshold()  const override;
     void  setNmsThreshold(float t) override;
     float nmsThreshold()   const override;
 
-    // 设置后端（需重新加载模型）
-    void setBackend(int backendId, int targetId);
+    // 两段式加载：prepareModel 不持锁，可在后台线程执行，期间旧模型照常推理；
+    // install 在持锁下替换网络，原网络归还 NetCache。loadModel 即两者依次调用
+    bool prepareModel(const std::string& modelPath, const std::string& labelsPath,
+                      PreparedModel& out) const;
+    void install(PreparedModel&& model);
+    // 不等待的 install：推理正在进行时立即返回 false，model 保持原样以便稍后重试
+    bool tryInstall(PreparedModel& model);
+    // 丢弃未生效的模型（已被更新的加载请求取代），网络归还 NetCache
+    void recycle(PreparedModel&& model);
+    ModelLoadStats lastLoadStats() const;
+
+    // 设置后端；已加载时按新后端重建（或从缓存取回）网络，失败则保留原网络
+    bool setBackend(int backendId, int targetId);
 
     // 获取推理耗时（ms，最近一次）
     double lastInferenceMsec() const;
 
+    // 批大小上限（≥ 1）
+    void setMaxBatch(int n);
+    int  maxBatch() const;
+
+    // 当前类别表（供 DetectionRenderer 使用）
+    const LabelMap& labels() const { return m_labels; }
+
 private:
-    // --- 推理流程 ---
-    cv::Mat   preprocess(const cv::Mat& frame);
-    DetectionList postprocess(const std::vector<cv::Mat>& outputs,
+    static bool   prepare(const std::string& modelPath, const std::string& labelsPath,
+                          const YOLOConfig& cfg, PreparedModel& out);
+    static double warmUp(cv::dnn::Net& net, const cv::Size& inputSize, int runs);
+    void installLocked(PreparedModel&& model);   // 调用方持有 m_mutex
+
+    // --- 推理流程（调用方持有 m_mutex） ---
+    // pred 为单帧输出 [4 + numClasses, numAnchors]
+    DetectionList postprocess(const cv::Mat& pred, const Letterbox& lb,
                               const cv::Size& origSize);
+    // 一次前向处理 frames[first, first + count)，结果追加到 results
+    bool forwardBatch(const std::vector<cv::Mat>& frames, std::size_t first,
+                      std::size_t count, std::vector<DetectionList>& results);
 
     YOLOConfig      m_cfg;
     cv::dnn::Net    m_net;
     LabelMap        m_labels;
+    NetKey          m_key;                  // 当前网络的缓存键
+    std::string     m_labelsPath;
+    ModelLoadStats  m_loadStats;
     bool            m_loaded = false;
     mutable std::mutex m_mutex;
     double          m_lastInfMs = 0.0;
     cv::Size        m_inputSize;
+    YoloPreprocessor m_pre;                  // 常驻输入张量
+    YoloPostprocessor m_post;                // 候选/NMS 缓冲跨帧复用
+    bool            m_fixedBatch = false;   // 模型批维固定为 1 时退化为逐帧前向
 };
\ No newline at end of file
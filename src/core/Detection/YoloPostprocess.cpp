@@ -0,0 +1,198 @@
+#include "YoloPostprocess.h"
+#include "LabelMap.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+namespace {
+
+// 与 cv::dnn 中 rectOverlap(jaccardDistance) 相同的计算顺序，保证阈值比较逐位一致
+inline float rectOverlap(const cv::Rect& a, const cv::Rect& b)
+{
+    const int Aa = a.area();
+    const int Ab = b.area();
+    if (Aa + Ab <= 0)
+        return 1.0f;
+    const double Aab = (a & b).area();
+    return 1.0f - static_cast<float>(1.0 - Aab / (Aa + Ab - Aab));
+}
+
+} // namespace
+
+DetectionList YoloPostprocessor::run(const cv::Mat& pred, const Letterbox& lb,
+                                     const cv::Size& origSize, float confThresh,
+                                     float nmsThresh, const LabelMap& labels)
+{
+    const int dims    = pred.rows;
+    const int anchors = pred.cols;
+    const int classes = dims - 4;
+
+    m_boxes.clear();
+    m_scores.clear();
+    m_classIds.clear();
+    if (classes <= 0)
+        return {};
+
+    // 1. 逐块 max/argmax：逐类别行与当前最大值比较，严格大于才更新，
+    //    与 minMaxLoc 取首个最大值的规则一致
+    float blockMax[kAnchorBlock];
+    int   blockArg[kAnchorBlock];
+    for (int a0 = 0; a0 < anchors; a0 += kAnchorBlock) {
+        const int n = std::min(kAnchorBlock, anchors - a0);
+        const float* first = pred.ptr<float>(4) + a0;
+        for (int i = 0; i < n; ++i) {
+            blockMax[i] = first[i];
+            blockArg[i] = 0;
+        }
+        for (int c = 1; c < classes; ++c) {
+            const float* row = pred.ptr<float>(4 + c) + a0;
+            for (int i = 0; i < n; ++i) {
+                const bool gt = row[i] > blockMax[i];
+                blockMax[i] = gt ? row[i] : blockMax[i];
+                blockArg[i] = gt ? c : blockArg[i];
+            }
+        }
+
+        // 2. 早拒：仅对过阈值的锚点解码框（中心点 → 左上角，撤销 letterbox）
+        const float* cxRow = pred.ptr<float>(0) + a0;
+        const float* cyRow = pred.ptr<float>(1) + a0;
+        const float* wRow  = pred.ptr<float>(2) + a0;
+        const float* hRow  = pred.ptr<float>(3) + a0;
+        for (int i = 0; i < n; ++i) {
+            if (blockMax[i] < confThresh)
+                continue;
+            const float cx = (cxRow[i] - lb.padX) / lb.scale;
+            const float cy = (cyRow[i] - lb.padY) / lb.scale;
+            const float bw = wRow[i] / lb.scale;
+            const float bh = hRow[i] / lb.scale;
+            m_boxes.emplace_back(cvRound(cx - bw / 2), cvRound(cy - bh / 2), cvRound(bw), cvRound(bh));
+            m_scores.push_back(blockMax[i]);
+            m_classIds.push_back(blockArg[i]);
+        }
+    }
+
+    // 3. 按类别升序分组（组内保持锚点顺序，与原 std::map 分组一致）
+    m_order.resize(m_boxes.size());
+    std::iota(m_order.begin(), m_order.end(), 0);
+    std::stable_sort(m_order.begin(), m_order.end(), [this](int a, int b) {
+        return m_classIds[static_cast<std::size_t>(a)] < m_classIds[static_cast<std::size_t>(b)];
+    });
+
+    const cv::Rect frameRect(0, 0, origSize.width, origSize.height);
+    DetectionList result;
+    std::size_t g = 0;
+    while (g < m_order.size()) {
+        const int classId = m_classIds[static_cast<std::size_t>(m_order[g])];
+        m_classBoxes.clear();
+        m_classScores.clear();
+        for (; g < m_order.size()
+               && m_classIds[static_cast<std::size_t>(m_order[g])] == classId; ++g) {
+            m_classBoxes.push_back(m_boxes[static_cast<std::size_t>(m_order[g])]);
+            m_classScores.push_back(m_scores[static_cast<std::size_t>(m_order[g])]);
+        }
+
+        nms(m_classBoxes, m_classScores, confThresh, nmsThresh, m_keep);
+
+        for (int k : m_keep) {
+            const cv::Rect box = m_classBoxes[static_cast<std::size_t>(k)] & frameRect;
+            if (box.empty())
+                continue;
+            Detection d;
+            d.bbox       = cv::Rect2f(static_cast<float>(box.x), static_cast<float>(box.y),
+                                      static_cast<float>(box.width), static_cast<float>(box.height));
+            d.classId    = classId;
+            d.confidence = m_classScores[static_cast<std::size_t>(k)];
+            d.label      = labels.nameOf(classId);
+            result.push_back(std::move(d));
+        }
+    }
+    return result;
+}
+
+void YoloPostprocessor::nms(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores,
+                            float scoreThresh, float nmsThresh, std::vector<int>& keep)
+{
+    keep.clear();
+
+    // 得分严格大于阈值者参与，按得分降序稳定排序（同 NMSBoxes）
+    m_sorted.clear();
+    for (int i = 0; i < static_cast<int>(scores.size()); ++i)
+        if (scores[static_cast<std::size_t>(i)] > scoreThresh)
+            m_sorted.push_back(i);
+    std::stable_sort(m_sorted.begin(), m_sorted.end(), [&](int a, int b) {
+        return scores[static_cast<std::size_t>(a)] > scores[static_cast<std::size_t>(b)];
+    });
+    if (m_sorted.empty())
+        return;
+
+    // 不相交的两个正面积框 overlap = 0：阈值 ≥ 0 时互不抑制，只需比较网格中相邻的已保留框。
+    // 面积 ≤ 0 的退化框不满足该前提，与所有已保留框逐一比较
+    const bool useGrid = nmsThresh >= 0.0f && m_sorted.size() > 16;
+    int gx0 = 0, gy0 = 0, gw = 1, gh = 1, cell = kGridCell;
+    if (useGrid) {
+        int x0 = INT_MAX, y0 = INT_MAX, x1 = INT_MIN, y1 = INT_MIN;
+        for (int i : m_sorted) {
+            const cv::Rect& r = boxes[static_cast<std::size_t>(i)];
+            x0 = std::min(x0, r.x);
+            y0 = std::min(y0, r.y);
+            x1 = std::max(x1, r.x + r.width);
+            y1 = std::max(y1, r.y + r.height);
+        }
+        const int span = std::max(x1 - x0, y1 - y0);
+        cell = std::max(kGridCell, span / kGridMaxDim + 1);
+        gx0 = x0;
+        gy0 = y0;
+        gw  = (x1 - x0) / cell + 1;
+        gh  = (y1 - y0) / cell + 1;
+        m_cells.resize(static_cast<std::size_t>(gw) * gh);
+        for (auto& c : m_cells)
+            c.clear();
+    }
+    m_degenerate.clear();
+
+    const auto cellRange = [&](const cv::Rect& r, int& cx0, int& cy0, int& cx1, int& cy1) {
+        cx0 = std::clamp((r.x - gx0) / cell, 0, gw - 1);
+        cy0 = std::clamp((r.y - gy0) / cell, 0, gh - 1);
+        cx1 = std::clamp((r.x + r.width  - gx0) / cell, 0, gw - 1);
+        cy1 = std::clamp((r.y + r.height - gy0) / cell, 0, gh - 1);
+    };
+
+    for (int idx : m_sorted) {
+        const cv::Rect& r = boxes[static_cast<std::size_t>(idx)];
+        const bool degenerate = r.width <= 0 || r.height <= 0;
+        bool keepIt = true;
+
+        const auto suppressedBy = [&](int k) {
+            return rectOverlap(r, boxes[static_cast<std::size_t>(k)]) > nmsThresh;
+        };
+
+        if (!useGrid || degenerate) {
+            for (int k : keep)
+                if (suppressedBy(k)) { keepIt = false; break; }
+        } else {
+            for (int k : m_degenerate)
+                if (suppressedBy(k)) { keepIt = false; break; }
+            int cx0, cy0, cx1, cy1;
+            cellRange(r, cx0, cy0, cx1, cy1);
+            for (int cy = cy0; keepIt && cy <= cy1; ++cy)
+                for (int cx = cx0; keepIt && cx <= cx1; ++cx)
+                    for (int k : m_cells[static_cast<std::size_t>(cy) * gw + cx])
+                        if (suppressedBy(k)) { keepIt = false; break; }
+        }
+        if (!keepIt)
+            continue;
+
+        keep.push_back(idx);
+        if (!useGrid)
+            continue;
+        if (degenerate) {
+            m_degenerate.push_back(idx);
+        } else {
+            int cx0, cy0, cx1, cy1;
+            cellRange(r, cx0, cy0, cx1, cy1);
+            for (int cy = cy0; cy <= cy1; ++cy)
+                for (int cx = cx0; cx <= cx1; ++cx)
+                    m_cells[static_cast<std::size_t>(cy) * gw + cx].push_back(idx);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Detection.h"
+#include "YoloPreprocess.h"
+#include <opencv2/core.hpp>
+#include <vector>
+
+class LabelMap;
+
+// YOLOv8 后处理：直接按原生布局 [4 + numClasses, numAnchors] 读取输出（不转置），
+// 按锚点分块做逐类别行的 max/argmax（内层为连续内存，便于编译器向量化），
+// 低于阈值的锚点不解码框；按类别 NMS 用空间网格只比较可能相交的已保留框。
+// 结果与逐锚点 minMaxLoc + 每类 cv::dnn::NMSBoxes 的原实现逐项一致
+class YoloPostprocessor {
+public:
+    DetectionList run(const cv::Mat& pred, const Letterbox& lb, const cv::Size& origSize,
+                      float confThresh, float nmsThresh, const LabelMap& labels);
+
+    // 与 cv::dnn::NMSBoxes(score_threshold, nms_threshold, eta = 1, top_k = 0) 相同的贪心 NMS，
+    // keep 为按得分降序（同分保持输入顺序）保留的下标
+    void nms(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores,
+             float scoreThresh, float nmsThresh, std::vector<int>& keep);
+
+private:
+    static constexpr int kAnchorBlock = 256;   // max/argmax 的锚点分块（缓冲驻留 L1）
+    static constexpr int kGridCell    = 64;    // NMS 网格单元边长（像素）
+    static constexpr int kGridMaxDim  = 64;
+
+    // 候选（跨帧复用）
+    std::vector<cv::Rect> m_boxes;
+    std::vector<float>    m_scores;
+    std::vector<int>      m_classIds;
+    std::vector<int>      m_order;   // 按类别分组后的候选下标
+
+    // NMS 缓冲
+    std::vector<cv::Rect>         m_classBoxes;
+    std::vector<float>            m_classScores;
+    std::vector<int>              m_keep;
+    std::vector<int>              m_sorted;
+    std::vector<std::vector<int>> m_cells;
+    std::vector<int>              m_degenerate;
+};
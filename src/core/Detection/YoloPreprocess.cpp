@@ -0,0 +1,138 @@
+#include "YoloPreprocess.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+YoloPreprocessor::YoloPreprocessor(cv::Size inputSize)
+    : m_inputSize(inputSize)
+{
+    // 与 blobFromImage(scalefactor = 1/255) 的逐像素结果一致
+    for (int v = 0; v < 256; ++v)
+        m_lut[static_cast<std::size_t>(v)] = static_cast<float>(v * (1.0 / 255.0));
+}
+
+void YoloPreprocessor::setInputSize(cv::Size size)
+{
+    if (size == m_inputSize)
+        return;
+    m_inputSize = size;
+    m_capacity  = 0;
+    m_storage.release();
+    m_blob.release();
+    m_slots.clear();
+}
+
+float* YoloPreprocessor::plane(int index, int channel)
+{
+    const std::size_t planeSize = static_cast<std::size_t>(m_inputSize.area());
+    return m_storage.ptr<float>() + (static_cast<std::size_t>(index) * 3 + channel) * planeSize;
+}
+
+const cv::Mat& YoloPreprocessor::prepare(int batch)
+{
+    batch = std::max(1, batch);
+    if (batch > m_capacity) {
+        const int sz[] = { batch, 3, m_inputSize.height, m_inputSize.width };
+        m_storage.create(4, sz, CV_32F);
+        m_capacity = batch;
+        m_slots.assign(static_cast<std::size_t>(batch), Slot{});
+    }
+    const int sz[] = { batch, 3, m_inputSize.height, m_inputSize.width };
+    m_blob = cv::Mat(4, sz, CV_32F, m_storage.ptr<float>());
+    return m_blob;
+}
+
+const cv::Mat& YoloPreprocessor::run(const cv::Mat& frame, Letterbox& lb)
+{
+    prepare(1);
+    lb = fill(0, frame);
+    return m_blob;
+}
+
+void YoloPreprocessor::writePadding(int index, const Slot& slot)
+{
+    // 仅在几何变化时整槽铺填充色，之后每帧只覆写有效区域
+    const float pad = m_lut[kPadValue];
+    const std::size_t planeSize = static_cast<std::size_t>(m_inputSize.area());
+    for (int c = 0; c < 3; ++c) {
+        float* p = plane(index, c);
+        if (slot.resized.area() == 0) {
+            std::fill(p, p + planeSize, pad);
+            continue;
+        }
+        const int x0 = slot.lb.padX;
+        const int x1 = x0 + slot.resized.width;
+        const int y0 = slot.lb.padY;
+        const int y1 = y0 + slot.resized.height;
+        for (int y = 0; y < m_inputSize.height; ++y) {
+            float* row = p + static_cast<std::size_t>(y) * m_inputSize.width;
+            if (y < y0 || y >= y1) {
+                std::fill(row, row + m_inputSize.width, pad);
+            } else {
+                std::fill(row, row + x0, pad);
+                std::fill(row + x1, row + m_inputSize.width, pad);
+            }
+        }
+    }
+}
+
+Letterbox YoloPreprocessor::fill(int index, const cv::Mat& frame)
+{
+    CV_Assert(index >= 0 && index < m_capacity);
+    Slot& slot = m_slots[static_cast<std::size_t>(index)];
+
+    const cv::Size src = frame.empty() ? cv::Size() : frame.size();
+    if (!slot.valid || slot.source != src) {
+        slot = Slot{};
+        slot.source = src;
+        if (src.area() > 0) {
+            // 等比缩放后居中
+            slot.lb.scale = std::min(m_inputSize.width  / static_cast<float>(src.width),
+                                     m_inputSize.height / static_cast<float>(src.height));
+            slot.resized  = cv::Size(cvRound(src.width * slot.lb.scale),
+                                     cvRound(src.height * slot.lb.scale));
+            slot.lb.padX  = (m_inputSize.width  - slot.resized.width)  / 2;
+            slot.lb.padY  = (m_inputSize.height - slot.resized.height) / 2;
+        }
+        writePadding(index, slot);
+        slot.valid = true;
+    }
+    if (src.area() == 0)
+        return slot.lb;
+
+    const cv::Mat* img = &frame;
+    if (frame.channels() != 3) {
+        cv::cvtColor(frame, m_converted, frame.channels() == 1 ? cv::COLOR_GRAY2BGR
+                                                               : cv::COLOR_BGRA2BGR);
+        img = &m_converted;
+    }
+    if (slot.resized != src) {
+        cv::resize(*img, m_resized, slot.resized);
+        img = &m_resized;
+    }
+
+    // 一次逐行扫描：BGR 交错 → RGB 平面，查表归一化
+    const int    W     = m_inputSize.width;
+    const int    cols  = slot.resized.width;
+    float* const planeR = plane(index, 0);
+    float* const planeG = plane(index, 1);
+    float* const planeB = plane(index, 2);
+    const float* lut   = m_lut.data();
+    const Letterbox lb = slot.lb;
+    const cv::Mat& in  = *img;
+
+    cv::parallel_for_(cv::Range(0, slot.resized.height), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const uchar* s = in.ptr<uchar>(y);
+            const std::size_t off = static_cast<std::size_t>(y + lb.padY) * W + lb.padX;
+            float* r = planeR + off;
+            float* g = planeG + off;
+            float* b = planeB + off;
+            for (int x = 0; x < cols; ++x) {
+                b[x] = lut[s[3 * x + 0]];
+                g[x] = lut[s[3 * x + 1]];
+                r[x] = lut[s[3 * x + 2]];
+            }
+        }
+    });
+    return lb;
+}
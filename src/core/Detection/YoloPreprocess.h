@@ -0,0 +1,53 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <array>
+#include <vector>
+
+// letterbox 的缩放与填充（postprocess 还原坐标用）
+struct Letterbox {
+    float scale = 1.0f;
+    int   padX  = 0;
+    int   padY  = 0;
+};
+
+// YOLO 输入预处理：直接写入常驻的 NCHW float 输入张量
+// 每个批槽按源尺寸缓存 letterbox 几何，尺寸不变时填充区无需重写；
+// 缩放仍由 cv::resize 完成（写入常驻缓冲），BGR→RGB、归一化与 HWC→CHW 合并为一次逐行扫描
+class YoloPreprocessor {
+public:
+    explicit YoloPreprocessor(cv::Size inputSize = { 640, 640 });
+
+    void     setInputSize(cv::Size size);
+    cv::Size inputSize() const { return m_inputSize; }
+
+    // 为 batch 帧准备张量（容量不足时才重新分配），返回 [batch, 3, H, W] 视图
+    const cv::Mat& prepare(int batch);
+
+    // 将 frame 写入批槽 index；frame 为空时写入全填充色
+    Letterbox fill(int index, const cv::Mat& frame);
+
+    // 单帧便捷接口：prepare(1) + fill(0)
+    const cv::Mat& run(const cv::Mat& frame, Letterbox& lb);
+
+    static constexpr int kPadValue = 114;
+
+private:
+    struct Slot {
+        cv::Size  source;        // 上次写入的源尺寸（几何缓存键）
+        cv::Size  resized;
+        Letterbox lb;
+        bool      valid = false; // 填充区已按当前几何写好
+    };
+
+    float* plane(int index, int channel);
+    void   writePadding(int index, const Slot& slot);
+
+    cv::Size             m_inputSize;
+    int                  m_capacity = 0;
+    cv::Mat              m_storage;   // [capacity, 3, H, W]
+    cv::Mat              m_blob;      // m_storage 前 batch 帧的视图
+    std::vector<Slot>    m_slots;
+    cv::Mat              m_resized;   // 缩放中间缓冲，跨帧复用
+    cv::Mat              m_converted; // 非 BGR 输入的转换缓冲
+    std::array<float, 256> m_lut{};   // 8U → [0, 1] 归一化表
+};
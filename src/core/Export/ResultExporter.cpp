@@ -0,0 +1,199 @@
+#include "ResultExporter.h"
+#include <opencv2/imgcodecs.hpp>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+// JSON 字符串转义（标签名仅含可打印 ASCII，处理引号与反斜杠即可）
+std::string jsonEscape(const std::string& s)
+{
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// CSV 字段：含逗号或引号时加引号包裹
+std::string csvField(const std::string& s)
+{
+    if (s.find_first_of(",\"") == std::string::npos)
+        return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"')
+            out += '"';
+        out += c;
+    }
+    return out + '"';
+}
+
+} // namespace
+
+ResultExporter::ResultExporter(std::filesystem::path filePath, Format fmt)
+    : m_path(std::move(filePath))
+    , m_fmt(fmt)
+{}
+
+ResultExporter::~ResultExporter()
+{
+    close();
+}
+
+bool ResultExporter::open()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_ofs.is_open())
+        return true;
+
+    std::error_code ec;
+    if (m_path.has_parent_path())
+        std::filesystem::create_directories(m_path.parent_path(), ec);
+
+    m_ofs.open(m_path, std::ios::out | std::ios::trunc);
+    if (!m_ofs.is_open())
+        return false;
+
+    m_firstFrame = true;
+    if (m_fmt == Format::CSV)
+        writeCsvHeader();
+    else
+        m_ofs << "{\n  \"frames\": [";
+    return true;
+}
+
+void ResultExporter::appendFrame(std::int64_t timestampMsec, const DetectionList& detections)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_ofs.is_open())
+        return;
+
+    if (m_fmt == Format::CSV) {
+        for (const Detection& d : detections)
+            writeCsvRow(timestampMsec, d);
+        return;
+    }
+
+    writeJsonFrameOpen(timestampMsec, detections.size());
+    for (std::size_t i = 0; i < detections.size(); ++i)
+        writeJsonDetection(detections[i], i + 1 == detections.size());
+    writeJsonFrameClose();
+}
+
+void ResultExporter::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_ofs.is_open())
+        return;
+    if (m_fmt == Format::JSON)
+        writeJsonFooter();
+    m_ofs.flush();
+    m_ofs.close();
+}
+
+bool ResultExporter::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_ofs.is_open();
+}
+
+void ResultExporter::writeCsvHeader()
+{
+    m_ofs << "timestamp_ms,track_id,class_id,label,confidence,x,y,width,height\n";
+}
+
+void ResultExporter::writeCsvRow(std::int64_t ts, const Detection& d)
+{
+    m_ofs << ts << ',' << d.trackId << ',' << d.classId << ',' << csvField(d.label) << ','
+          << std::fixed << std::setprecision(4) << d.confidence << ','
+          << std::setprecision(1)
+          << d.bbox.x << ',' << d.bbox.y << ',' << d.bbox.width << ',' << d.bbox.height << '\n';
+    m_ofs.unsetf(std::ios::floatfield);
+}
+
+void ResultExporter::writeJsonFrameOpen(std::int64_t ts, std::size_t count)
+{
+    m_ofs << (m_firstFrame ? "\n" : ",\n")
+          << "    {\"timestamp_ms\": " << ts << ", \"count\": " << count
+          << ", \"detections\": [";
+    m_firstFrame = false;
+}
+
+void ResultExporter::writeJsonDetection(const Detection& d, bool last)
+{
+    m_ofs << "{\"track_id\": " << d.trackId
+          << ", \"class_id\": " << d.classId
+          << ", \"label\": \"" << jsonEscape(d.label) << '"'
+          << ", \"confidence\": " << std::fixed << std::setprecision(4) << d.confidence
+          << std::setprecision(1)
+          << ", \"bbox\": [" << d.bbox.x << ", " << d.bbox.y << ", "
+          << d.bbox.width << ", " << d.bbox.height << "]}"
+          << (last ? "" : ", ");
+    m_ofs.unsetf(std::ios::floatfield);
+}
+
+void ResultExporter::writeJsonFrameClose()
+{
+    m_ofs << "]}";
+}
+
+void ResultExporter::writeJsonFooter()
+{
+    m_ofs << "\n  ]\n}\n";
+}
+
+std::string ResultExporter::generateScreenshotFilename(ImageFormat fmt)
+{
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t t = std::chrono::system_clock::to_time_t(now);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now.time_since_epoch()).count() % 1000;
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    std::ostringstream oss;
+    oss << "screenshot_" << std::put_time(&tm, "%Y%m%d_%H%M%S")
+        << '_' << std::setw(3) << std::setfill('0') << ms
+        << (fmt == ImageFormat::PNG ? ".png" : ".jpg");
+    return oss.str();
+}
+
+std::filesystem::path ResultExporter::saveScreenshot(const cv::Mat& frame,
+                                                     const std::filesystem::path& outputDir,
+                                                     ImageFormat fmt, int jpegQuality)
+{
+    std::error_code ec;
+    if (!outputDir.empty())
+        std::filesystem::create_directories(outputDir, ec);
+
+    const std::filesystem::path path = outputDir / generateScreenshotFilename(fmt);
+    return saveScreenshotTo(frame, path, jpegQuality) ? path : std::filesystem::path{};
+}
+
+bool ResultExporter::saveScreenshotTo(const cv::Mat& frame,
+                                      const std::filesystem::path& filePath,
+                                      int jpegQuality)
+{
+    if (frame.empty())
+        return false;
+
+    std::vector<int> params;
+    const std::string ext = filePath.extension().string();
+    if (ext == ".jpg" || ext == ".jpeg")
+        params = { cv::IMWRITE_JPEG_QUALITY, jpegQuality };
+
+    try {
+        return cv::imwrite(filePath.string(), frame, params);
+    } catch (const cv::Exception&) {
+        return false;
+    }
+}
@@ -0,0 +1,144 @@
+#include "VideoRecorder.h"
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+VideoRecorder::VideoRecorder(RecordConfig cfg)
+    : m_cfg(std::move(cfg))
+{}
+
+VideoRecorder::~VideoRecorder()
+{
+    if (isRecording())
+        stop();
+}
+
+void VideoRecorder::setConfig(RecordConfig cfg)
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (!m_recording)
+        m_cfg = std::move(cfg);
+}
+
+bool VideoRecorder::start()
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    if (m_recording)
+        return false;
+
+    std::error_code ec;
+    if (!m_cfg.outputDir.empty())
+        std::filesystem::create_directories(m_cfg.outputDir, ec);
+
+    m_currentPath = m_cfg.outputDir / generateFilename();
+    m_queue.clear();
+    m_frameCount = 0;
+    m_droppedFrames = 0;
+    m_stopIo = false;
+    m_recording = true;
+
+    // VideoWriter 在 I/O 线程收到第一帧时按其尺寸打开
+    m_ioThread = std::thread(&VideoRecorder::ioThreadFunc, this);
+    return true;
+}
+
+void VideoRecorder::writeFrame(const cv::Mat& frame)
+{
+    if (frame.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (!m_recording)
+            return;
+        if (m_queue.size() >= m_cfg.maxQueueSize) {
+            m_queue.pop_front();
+            ++m_droppedFrames;
+        }
+        // 按引用入队：缓冲池与采集槽位以 refcount 判定空闲，队列持有期间不会被复写
+        m_queue.push_back(frame);
+        ++m_frameCount;
+    }
+    m_queueCv.notify_one();
+}
+
+std::filesystem::path VideoRecorder::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (!m_recording)
+            return {};
+        m_stopIo = true;
+    }
+    m_queueCv.notify_one();
+    if (m_ioThread.joinable())
+        m_ioThread.join();
+
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_recording = false;
+    return m_currentPath;
+}
+
+bool VideoRecorder::isRecording() const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_recording;
+}
+
+std::size_t VideoRecorder::frameCount() const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_frameCount;
+}
+
+double VideoRecorder::durationSec() const
+{
+    return m_cfg.fps > 0.0 ? static_cast<double>(frameCount()) / m_cfg.fps : 0.0;
+}
+
+std::size_t VideoRecorder::droppedFrames() const
+{
+    return m_droppedFrames;
+}
+
+void VideoRecorder::ioThreadFunc()
+{
+    for (;;) {
+        cv::Mat frame;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCv.wait(lock, [this] { return m_stopIo || !m_queue.empty(); });
+            if (m_queue.empty())
+                break;   // 停止且队列已清空
+            frame = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        if (!m_writer.isOpened()) {
+            m_writer.open(m_currentPath.string(), m_cfg.fourcc, m_cfg.fps,
+                          frame.size(), frame.channels() == 3);
+            if (!m_writer.isOpened())
+                continue;
+        }
+        m_writer.write(frame);
+    }
+
+    if (m_writer.isOpened())
+        m_writer.release();
+}
+
+std::string VideoRecorder::generateFilename() const
+{
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t t = std::chrono::system_clock::to_time_t(now);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    std::ostringstream oss;
+    oss << m_cfg.prefix << '_' << std::put_time(&tm, "%Y%m%d_%H%M%S") << ".mp4";
+    return oss.str();
+}
@@ -22,10 +22,14 @@ public:
     explicit VideoRecorder(RecordConfig cfg = {});
     ~VideoRecorder();
 
+    // 更新配置（录制中调用无效，下次 start 生效）
+    void setConfig(RecordConfig cfg);
+
     // 开始录制（启动内部 I/O 线程，自动生成带时间戳的文件名）
     bool start();
 
     // 将帧入队（非阻塞，< 0.1ms；队列满时丢弃最老帧并递增 droppedFrames）
+    // 只增加引用计数、不拷贝像素：调用方此后不得原地改写该帧的数据
     void writeFrame(const cv::Mat& frame);
 
     // 停止录制：等待队列清空后 flush 并关闭文件，返回最终输出路径
@@ -0,0 +1,25 @@
+#pragma once
+#include <memory>
+
+// 原子发布的参数块：UI 线程整体替换，帧线程读取不可变快照
+// 读写双方只在交换指针的瞬间同步，帧线程永远不会等待一次完整的处理过程
+template <typename T>
+class AtomicParams {
+public:
+    explicit AtomicParams(T init = {})
+        : m_ptr(std::make_shared<const T>(std::move(init)))
+    {}
+
+    void store(T value)
+    {
+        std::atomic_store(&m_ptr, std::make_shared<const T>(std::move(value)));
+    }
+
+    T load() const
+    {
+        return *std::atomic_load(&m_ptr);
+    }
+
+private:
+    std::shared_ptr<const T> m_ptr;
+};
@@ -7,24 +7,24 @@ CannyFilter::CannyFilter(CannyParams p)
 
 void CannyFilter::setParams(CannyParams p)
 {
-    std::lock_guard<std::mutex> lock(m_mu);
-    m_params = p;
+    m_params.store(p);
 }
 
-cv::Mat CannyFilter::apply(const cv::Mat& src)
+CannyParams CannyFilter::params() const
 {
-    if (!m_enabled)
-        return src.clone();
+    return m_params.load();
+}
+
+void CannyFilter::applyImpl(const cv::Mat& src, cv::Mat& dst)
+{
+    const CannyParams p = m_params.load();
 
-    CannyParams p;
-    {
-        std::lock_guard<std::mutex> lock(m_mu);
-        p = m_params;
+    if (src.channels() == 1) {
+        cv::Canny(src, dst, p.threshold1, p.threshold2, p.apertureSize, p.l2gradient);
+        return;
     }
 
-    cv::Mat gray, edges, bgr;
+    thread_local cv::Mat gray;
     cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
-    cv::Canny(gray, edges, p.threshold1, p.threshold2, p.apertureSize, p.l2gradient);
-    cv::cvtColor(edges, bgr, cv::COLOR_GRAY2BGR);
-    return bgr;
+    cv::Canny(gray, dst, p.threshold1, p.threshold2, p.apertureSize, p.l2gradient);
 }
@@ -1,6 +1,6 @@
 #pragma once
 #include "FilterBase.h"
-#include <mutex>
+#include "AtomicParams.h"
 
 struct CannyParams {
     double threshold1   = 50.0;
@@ -13,12 +13,21 @@ class CannyFilter : public FilterBase {
 public:
     explicit CannyFilter(CannyParams p = {});
     void setParams(CannyParams p);
+    CannyParams params() const;
 
     std::string id()   const override { return "canny"; }
     std::string name() const override { return "Canny 边缘检测"; }
-    cv::Mat apply(const cv::Mat& src) override;
+
+    bool accepts(const FrameFormat&) const override { return true; }
+    FrameFormat outputFormat(const FrameFormat&) const override { return FrameFormat::gray(); }
+    // 滞后阈值沿弱边缘链整帧传播，任何有限 halo 都无法保证与整帧结果一致
+    int haloRows() const override { return kFullFrame; }
+
+    std::shared_ptr<FilterBase> clone() const override { return std::make_shared<CannyFilter>(params()); }
+
+protected:
+    void applyImpl(const cv::Mat& src, cv::Mat& dst) override;
 
 private:
-    CannyParams        m_params;
-    mutable std::mutex m_mu;
+    AtomicParams<CannyParams> m_params;
 };
@@ -1,13 +1,54 @@
 #pragma once
 #include <opencv2/core.hpp>
 #include <string>
+#include <atomic>
+#include <memory>
+
+enum class ColorSpace { BGR, Gray };
+
+// 帧格式描述：在滤镜链各级之间传递，使滤镜可原生接收/输出 8UC1，
+// 仅在链末端（显示/录制）统一转换一次 BGR
+struct FrameFormat {
+    int        channels = 3;
+    int        depth    = CV_8U;
+    ColorSpace space    = ColorSpace::BGR;
+
+    static FrameFormat bgr()  { return {3, CV_8U, ColorSpace::BGR}; }
+    static FrameFormat gray() { return {1, CV_8U, ColorSpace::Gray}; }
+
+    // 由 Mat 推断格式（单通道视为灰度）
+    static FrameFormat of(const cv::Mat& m)
+    {
+        return { m.channels(), m.depth(),
+                 m.channels() == 1 ? ColorSpace::Gray : ColorSpace::BGR };
+    }
+
+    int  type()   const { return CV_MAKETYPE(depth, channels); }
+    bool isGray() const { return space == ColorSpace::Gray; }
+};
 
 class FilterBase {
 public:
     virtual ~FilterBase() = default;
 
-    // 对 src 施加滤镜，返回处理后的帧
-    virtual cv::Mat apply(const cv::Mat& src) = 0;
+    // 对 src 施加滤镜，返回新分配的帧（便捷接口）
+    cv::Mat apply(const cv::Mat& src)
+    {
+        cv::Mat dst;
+        apply(src, dst);
+        return dst;
+    }
+
+    // 对 src 施加滤镜，写入调用方提供的 dst；
+    // dst 尺寸/类型已匹配时直接复用其缓冲区，不重新分配。dst 不得与 src 共享数据
+    void apply(const cv::Mat& src, cv::Mat& dst)
+    {
+        if (!m_enabled) {
+            src.copyTo(dst);
+            return;
+        }
+        applyImpl(src, dst);
+    }
 
     // 滤镜唯一标识符（用于序列化/UI 匹配）
     virtual std::string id() const = 0;
@@ -15,10 +56,38 @@ public:
     // 人类可读名称
     virtual std::string name() const = 0;
 
-    // 是否启用（禁用时 apply 直接返回 src 的克隆）
+    // 能否直接处理该格式的输入（默认仅 BGR，链会在之前补一次转换）
+    virtual bool accepts(const FrameFormat& in) const { return !in.isGray(); }
+
+    // 给定输入格式时的输出格式（默认与输入相同）
+    virtual FrameFormat outputFormat(const FrameFormat& in) const { return in; }
+
+    // 条带并行时每条带上下需额外读取的行数（halo，即处理半径）
+    // kFullFrame 表示依赖整帧统计（直方图、Otsu 等），链在此处回退为整帧执行
+    static constexpr int kFullFrame = -1;
+    virtual int haloRows() const { return kFullFrame; }
+
+    // 以当前参数构造的新实例：启用状态、处理比例与帧间状态（时域 LUT 等）均为初始值
+    // 供需独立运行的链使用（如 FilterPipeline），避免与实时链共享有状态滤镜
+    virtual std::shared_ptr<FilterBase> clone() const = 0;
+
+    // 过载时可整级跳过的增强类滤镜（跳过后链的输出格式与语义不变，仅画质下降）
+    virtual bool degradable() const { return false; }
+
+    // 是否启用（禁用时 apply 直接拷贝 src）
     bool enabled() const { return m_enabled; }
     void setEnabled(bool e) { m_enabled = e; }
 
+    // 处理分辨率相对源分辨率的比例（代理分辨率预览时 < 1）
+    // 空间参数（核尺寸、邻域大小）按此比例缩放，使代理帧上的效果与全分辨率视觉等效
+    void   setProcessingScale(double s) { m_scale = s > 0.0 ? s : 1.0; }
+    double processingScale() const { return m_scale; }
+
 protected:
-    bool m_enabled = true;
+    // 子类实现：src 格式满足 accepts()，结果写入 dst（尽量复用 dst 现有缓冲区）
+    // 中间临时缓冲区用 thread_local，保证跨帧复用且可重入
+    virtual void applyImpl(const cv::Mat& src, cv::Mat& dst) = 0;
+
+    std::atomic<bool>   m_enabled{true};   // UI 线程写，帧线程读
+    std::atomic<double> m_scale{1.0};      // 帧线程在执行前写入
 };
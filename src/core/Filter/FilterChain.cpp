@@ -1,54 +1,277 @@
 #include "FilterChain.h"
+#include "FusedKernels.h"
+#include <opencv2/imgproc.hpp>
 #include <algorithm>
 
+FilterChain::FilterChain()
+    : m_filters(std::make_shared<const FilterList>())
+    , m_pool(kPoolCapacity)
+{}
+
+FilterChain::Snapshot FilterChain::snapshot() const
+{
+    return std::atomic_load(&m_filters);
+}
+
+void FilterChain::publish(Snapshot next)
+{
+    std::atomic_store(&m_filters, std::move(next));
+}
+
 void FilterChain::append(FilterPtr filter)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_filters.push_back(std::move(filter));
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto next = std::make_shared<FilterList>(*snapshot());
+    next->push_back(std::move(filter));
+    publish(std::move(next));
 }
 
 void FilterChain::remove(const std::string& filterId)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_filters.erase(
-        std::remove_if(m_filters.begin(), m_filters.end(),
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto next = std::make_shared<FilterList>(*snapshot());
+    next->erase(
+        std::remove_if(next->begin(), next->end(),
             [&filterId](const FilterPtr& f) { return f->id() == filterId; }),
-        m_filters.end());
+        next->end());
+    publish(std::move(next));
 }
 
 void FilterChain::move(std::size_t from, std::size_t to)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (from >= m_filters.size() || to >= m_filters.size() || from == to)
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto next = std::make_shared<FilterList>(*snapshot());
+    if (from >= next->size() || to >= next->size() || from == to)
         return;
 
-    FilterPtr filter = m_filters[from];
-    m_filters.erase(m_filters.begin() + static_cast<std::ptrdiff_t>(from));
-    m_filters.insert(m_filters.begin() + static_cast<std::ptrdiff_t>(to), std::move(filter));
+    FilterPtr filter = (*next)[from];
+    next->erase(next->begin() + static_cast<std::ptrdiff_t>(from));
+    next->insert(next->begin() + static_cast<std::ptrdiff_t>(to), std::move(filter));
+    publish(std::move(next));
 }
 
 void FilterChain::clear()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_filters.clear();
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    publish(std::make_shared<const FilterList>());
 }
 
 cv::Mat FilterChain::process(const cv::Mat& src)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    return process(src, m_scale);
+}
+
+cv::Mat FilterChain::process(const cv::Mat& src, double spatialScale)
+{
+    const Snapshot filters = snapshot();
+
+    std::lock_guard<std::mutex> lock(m_processMutex);
+    const std::size_t poolBefore = m_pool.allocations();
+
+    FrameFormat fmt;
+    cv::Mat frame = toBgrPooled(run(*filters, src, fmt, spatialScale));
+
+    countAllocations(poolBefore);
+    return frame;
+}
+
+cv::Mat FilterChain::processNative(const cv::Mat& src, FrameFormat* outFmt)
+{
+    const Snapshot filters = snapshot();
+
+    std::lock_guard<std::mutex> lock(m_processMutex);
+    const std::size_t poolBefore = m_pool.allocations();
+
+    FrameFormat fmt;
+    cv::Mat frame = run(*filters, src, fmt, m_scale);
+    if (outFmt)
+        *outFmt = fmt;
+
+    countAllocations(poolBefore);
+    return frame;
+}
+
+void FilterChain::setStripeConfig(StripeConfig cfg)
+{
+    m_stripeCfg.store(cfg);
+}
+
+StripeConfig FilterChain::stripeConfig() const
+{
+    return m_stripeCfg.load();
+}
+
+cv::Mat FilterChain::run(const FilterList& filters, const cv::Mat& src, FrameFormat& fmt,
+                         double scale)
+{
+    const StripeConfig cfg = m_stripeCfg.load();
+
+    // 1. 规划：仅当下一级不接受当前格式时才补一次 GRAY → BGR
+    m_plan.clear();
+    m_planFilters.clear();
+    fmt = FrameFormat::of(src);
+    const bool degraded = m_degraded;
+    for (const auto& f : filters) {
+        if (!f->enabled() || (degraded && f->degradable()))
+            continue;
+        f->setProcessingScale(scale);
+
+        Stage st;
+        st.filter     = f.get();
+        st.toBgrFirst = !f->accepts(fmt);
+        if (st.toBgrFirst)
+            fmt = FrameFormat::bgr();
+        st.in   = fmt;
+        st.out  = f->outputFormat(fmt);
+        st.halo = cfg.enabled ? f->haloRows() : FilterBase::kFullFrame;
+        fmt = st.out;
+        m_plan.push_back(st);
+        m_planFilters.push_back(f.get());
+    }
+
+    // 2. 执行：优先匹配融合序列；相邻的可分条带级合并为一段，整帧级逐个执行
+    const bool fusion = m_fusion;
     cv::Mat frame = src;
-    for (const auto& f : m_filters) {
-        if (f->enabled()) {
-            frame = f->apply(frame);
+    std::size_t i = 0;
+    while (i < m_plan.size()) {
+        if (fusion) {
+            const std::size_t used = runFused(i, frame);
+            if (used > 0) {
+                i += used;
+                continue;
+            }
+        }
+
+        std::size_t j = i;
+        int halo = 0;
+        while (j < m_plan.size() && m_plan[j].halo >= 0)
+            halo += m_plan[j++].halo;
+
+        const int stripes = (j > i) ? stripeCount(cfg, frame.rows, halo) : 1;
+        if (stripes > 1) {
+            frame = runStriped(&m_plan[i], &m_plan[0] + j, frame, halo, stripes);
+            i = j;
+        } else {
+            frame = runStage(m_plan[i], frame);
+            ++i;
         }
     }
     return frame;
 }
 
+cv::Mat FilterChain::runStage(const Stage& stage, const cv::Mat& frame)
+{
+    const cv::Mat in = stage.toBgrFirst ? toBgrPooled(frame) : frame;
+
+    // 输出写入池中缓冲区；上一级的缓冲区在 frame 被覆盖后自动归还
+    cv::Mat out = m_pool.acquire(in.size(), stage.out.type());
+    const uchar* before = out.data;
+    stage.filter->apply(in, out);
+    if (out.data != before)
+        ++m_stageReallocs;
+    return out;
+}
+
+std::size_t FilterChain::runFused(std::size_t first, cv::Mat& frame)
+{
+    const Stage& head = m_plan[first];
+    if (head.toBgrFirst)
+        return 0;
+
+    const FusedKernels::Plan plan = FusedKernels::match(
+        &m_planFilters[first], m_planFilters.size() - first, head.in);
+    if (plan.kind == FusedKernels::Kind::None)
+        return 0;
+
+    cv::Mat out = m_pool.acquire(frame.size(), CV_8UC1);
+    const uchar* before = out.data;
+    FusedKernels::run(plan, frame, out);
+    if (out.data != before)
+        ++m_stageReallocs;
+
+    frame = out;
+    return plan.length;
+}
+
+cv::Mat FilterChain::runStriped(const Stage* first, const Stage* last,
+                                const cv::Mat& frame, int halo, int stripes)
+{
+    cv::Mat dst = m_pool.acquire(frame.size(), (last - 1)->out.type());
+    const int rows = frame.rows;
+
+    cv::parallel_for_(cv::Range(0, stripes), [&](const cv::Range& range) {
+        // 每个工作线程一对乒乓缓冲区，跨帧复用
+        thread_local cv::Mat bufA, bufB;
+
+        for (int s = range.start; s < range.end; ++s) {
+            const int y0 = rows * s / stripes;
+            const int y1 = rows * (s + 1) / stripes;
+            const int a  = std::max(0, y0 - halo);
+            const int b  = std::min(rows, y1 + halo);
+
+            // 第一级直接读源帧 ROI，边界处可取到真实邻域像素；
+            // 之后各级在条带缓冲区边缘的误差总和不超过 halo，裁掉即可
+            cv::Mat  cur = frame.rowRange(a, b);
+            cv::Mat* out = &bufA;
+            auto flip = [&]() {
+                cur = *out;
+                out = (out == &bufA) ? &bufB : &bufA;
+            };
+            for (const Stage* st = first; st != last; ++st) {
+                if (st->toBgrFirst) {
+                    cv::cvtColor(cur, *out, cv::COLOR_GRAY2BGR);
+                    flip();
+                }
+                st->filter->apply(cur, *out);
+                flip();
+            }
+            cur.rowRange(y0 - a, y1 - a).copyTo(dst.rowRange(y0, y1));
+        }
+    }, stripes);
+
+    return dst;
+}
+
+int FilterChain::stripeCount(const StripeConfig& cfg, int rows, int halo) const
+{
+    int n = cfg.stripes > 0 ? cfg.stripes : cv::getNumThreads();
+    const int minRows = std::max({cfg.minStripeRows, 2 * halo, 1});
+    n = std::min(n, rows / minRows);
+    return std::max(n, 1);
+}
+
+cv::Mat FilterChain::toBgr(const cv::Mat& frame)
+{
+    if (frame.channels() != 1)
+        return frame;
+
+    cv::Mat bgr;
+    cv::cvtColor(frame, bgr, cv::COLOR_GRAY2BGR);
+    return bgr;
+}
+
+cv::Mat FilterChain::toBgrPooled(const cv::Mat& frame)
+{
+    if (frame.channels() != 1)
+        return frame;
+
+    cv::Mat bgr = m_pool.acquire(frame.size(), CV_8UC3);
+    cv::cvtColor(frame, bgr, cv::COLOR_GRAY2BGR);
+    return bgr;
+}
+
+void FilterChain::countAllocations(std::size_t poolBefore)
+{
+    const std::size_t n = (m_pool.allocations() - poolBefore) + m_stageReallocs;
+    m_stageReallocs = 0;
+    m_lastFrameAllocs = n;
+    m_totalAllocs += n;
+}
+
 FilterChain::FilterPtr FilterChain::find(const std::string& filterId)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (const auto& f : m_filters) {
+    const Snapshot filters = snapshot();
+    for (const auto& f : *filters) {
         if (f->id() == filterId)
             return f;
     }
@@ -57,6 +280,5 @@ FilterChain::FilterPtr FilterChain::find(const std::string& filterId)
 
 std::size_t FilterChain::size() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_filters.size();
+    return snapshot()->size();
 }
@@ -1,12 +1,29 @@
 #pragma once
 #include "FilterBase.h"
+#include "FramePool.h"
+#include "AtomicParams.h"
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <atomic>
 
+// 条带并行配置：帧按水平条带切分，连续的可分条带滤镜在每个条带上整段执行，
+// 条带在各级之间保持缓存驻留，一段只需一次 fork/join
+struct StripeConfig {
+    bool enabled       = false;
+    int  stripes       = 0;    // 0 = cv::getNumThreads()
+    int  minStripeRows = 64;   // 条带过矮时 halo 冗余占比过高，自动减少条带数
+};
+
+// 滤镜链：RCU 风格的不可变快照
+// 增删/排序在写锁内复制列表后原子替换指针；process 只原子读取快照，不与 UI 线程争锁
 class FilterChain {
 public:
-    using FilterPtr = std::shared_ptr<FilterBase>;
+    using FilterPtr  = std::shared_ptr<FilterBase>;
+    using FilterList = std::vector<FilterPtr>;
+    using Snapshot   = std::shared_ptr<const FilterList>;
+
+    FilterChain();
 
     // 追加滤镜到链末尾
     void append(FilterPtr filter);
@@ -20,15 +37,88 @@ public:
     // 清空
     void clear();
 
-    // 顺序执行所有启用的滤镜（线程安全）
+    // 顺序执行所有启用的滤镜，结果统一为 BGR（供显示/录制）
+    // 中间帧与输出帧均取自内部缓冲池，稳态下每帧零分配
+    // 应由单一帧线程调用；与增删/参数更新并发时使用调用时刻的快照
     cv::Mat process(const cv::Mat& src);
 
+    // 同上，但以指定的空间比例执行（全分辨率输出与代理预览交替处理时使用）
+    cv::Mat process(const cv::Mat& src, double spatialScale);
+
+    // 同上，但保留链末端的原生格式（可能为 8UC1），outFmt 可选返回其格式
+    cv::Mat processNative(const cv::Mat& src, FrameFormat* outFmt = nullptr);
+
+    // 链末端格式转换：8UC1 → BGR，其余原样返回
+    static cv::Mat toBgr(const cv::Mat& frame);
+
+    // 条带并行开关与参数（可在运行中切换）
+    void setStripeConfig(StripeConfig cfg);
+    StripeConfig stripeConfig() const;
+
+    // 处理比例：src 相对源分辨率的缩放（代理预览时 < 1），
+    // 执行前下发给各滤镜以缩放核尺寸等空间参数
+    void   setProcessingScale(double s) { m_scale = s > 0.0 ? s : 1.0; }
+    double processingScale() const { return m_scale; }
+
+    // 融合内核开关（默认开启）：命中已知相邻序列时以单次行带扫描代替逐级整帧处理
+    void setFusionEnabled(bool on) { m_fusion = on; }
+    bool fusionEnabled() const { return m_fusion; }
+
+    // 降级模式：跳过 degradable() 的滤镜（由帧调度器在预计超出帧预算时逐帧设置）
+    void setDegraded(bool on) { m_degraded = on; }
+    bool degraded() const { return m_degraded; }
+
+    // 当前滤镜列表的不可变快照
+    Snapshot snapshot() const;
+
     // 获取指定 id 的滤镜（用于参数更新）
     FilterPtr find(const std::string& filterId);
 
     std::size_t size() const;
 
+    // 最近一帧 process 期间发生的整帧缓冲区分配次数（稳态应为 0）
+    std::size_t lastFrameAllocations() const { return m_lastFrameAllocs; }
+
+    // 累计分配次数
+    std::size_t totalAllocations() const { return m_totalAllocs; }
+
 private:
-    std::vector<FilterPtr> m_filters;
-    mutable std::mutex     m_mutex;
+    // 执行计划中的一级：格式转换已预先确定
+    struct Stage {
+        FilterBase* filter     = nullptr;
+        bool        toBgrFirst = false;   // 执行前需 GRAY → BGR
+        FrameFormat in;
+        FrameFormat out;
+        int         halo       = FilterBase::kFullFrame;
+    };
+
+    void    publish(Snapshot next);
+    cv::Mat run(const FilterList& filters, const cv::Mat& src, FrameFormat& fmt, double scale);
+    cv::Mat runStage(const Stage& stage, const cv::Mat& frame);
+    std::size_t runFused(std::size_t first, cv::Mat& frame);
+    cv::Mat runStriped(const Stage* first, const Stage* last,
+                       const cv::Mat& frame, int halo, int stripes);
+    int     stripeCount(const StripeConfig& cfg, int rows, int halo) const;
+    cv::Mat toBgrPooled(const cv::Mat& frame);
+    void    countAllocations(std::size_t poolBefore);
+
+    Snapshot   m_filters;      // 仅经 std::atomic_load/atomic_store 访问
+    std::mutex m_writeMutex;   // 串行化写者（UI 线程之间），读者不参与
+
+    AtomicParams<StripeConfig> m_stripeCfg;
+    std::atomic<bool>          m_fusion{true};
+    std::atomic<bool>          m_degraded{false};
+    std::atomic<double>        m_scale{1.0};
+
+    // 代理与全分辨率两种尺寸可能在同一帧内交替出现，各自需保有中间/输出缓冲
+    static constexpr std::size_t kPoolCapacity = 8;
+
+    // ──── 缓冲池（仅帧线程在 m_processMutex 内访问） ────
+    std::mutex               m_processMutex;
+    FramePool                m_pool;
+    std::vector<Stage>       m_plan;                // 每帧复用
+    std::vector<FilterBase*> m_planFilters;         // 与 m_plan 对应，供融合匹配
+    std::size_t              m_stageReallocs = 0;   // 滤镜自行重建 dst 的次数
+    std::atomic<std::size_t> m_lastFrameAllocs{0};
+    std::atomic<std::size_t> m_totalAllocs{0};
 };
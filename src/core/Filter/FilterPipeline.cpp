@@ -0,0 +1,147 @@
+#include "FilterPipeline.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+FilterPipeline::FilterPipeline(FilterChain::Snapshot filters, PipelineConfig cfg)
+    : m_cfg(cfg)
+{
+    // 构造时克隆启用的滤镜：流水线各级与实时链并发运行，不得共享有状态滤镜
+    // （HistEq 的 CLAHE/时域 LUT、处理比例等）；参数取构造时的快照，之后的修改不影响本流水线
+    std::vector<FilterChain::FilterPtr> enabled;
+    for (const auto& f : *filters) {
+        if (f->enabled())
+            enabled.push_back(f->clone());
+    }
+
+    const int depth = std::max(m_cfg.queueDepth, 1);
+    int nStages = m_cfg.stages > 0 ? m_cfg.stages : static_cast<int>(enabled.size());
+    nStages = std::max(1, std::min(nStages, std::max<int>(1, static_cast<int>(enabled.size()))));
+
+    for (int i = 0; i <= nStages; ++i)
+        m_queues.push_back(std::make_unique<Queue>(static_cast<std::size_t>(depth)));
+
+    // 按顺序把滤镜均分到各级
+    const std::size_t n = enabled.size();
+    for (int i = 0; i < nStages; ++i) {
+        auto stage = std::make_unique<Stage>();
+        const std::size_t b = n * static_cast<std::size_t>(i)     / static_cast<std::size_t>(nStages);
+        const std::size_t e = n * static_cast<std::size_t>(i + 1) / static_cast<std::size_t>(nStages);
+        stage->filters.assign(enabled.begin() + static_cast<std::ptrdiff_t>(b),
+                              enabled.begin() + static_cast<std::ptrdiff_t>(e));
+        stage->pool   = FramePool(static_cast<std::size_t>(depth) + 3);   // 覆盖下游在途帧
+        stage->isLast = (i == nStages - 1);
+        stage->in     = m_queues[static_cast<std::size_t>(i)].get();
+        stage->out    = m_queues[static_cast<std::size_t>(i) + 1].get();
+        m_stages.push_back(std::move(stage));
+    }
+}
+
+FilterPipeline::~FilterPipeline()
+{
+    stop();
+}
+
+void FilterPipeline::start()
+{
+    if (m_started)
+        return;
+    m_started = true;
+    m_stop    = false;
+    for (auto& stage : m_stages) {
+        Stage* s = stage.get();
+        s->thread = std::thread([this, s] { stageLoop(*s); });
+    }
+}
+
+void FilterPipeline::stop()
+{
+    m_stop = true;
+    for (auto& stage : m_stages) {
+        if (stage->thread.joinable())
+            stage->thread.join();
+    }
+    m_started = false;
+}
+
+bool FilterPipeline::push(const cv::Mat& frame)
+{
+    Item item;
+    item.frame = frame;
+    item.fmt   = FrameFormat::of(frame);
+    return m_queues.front()->push(item, m_stop);
+}
+
+void FilterPipeline::finish()
+{
+    Item item;
+    item.end = true;
+    m_queues.front()->push(item, m_stop);
+}
+
+bool FilterPipeline::pop(cv::Mat& out)
+{
+    Item item;
+    if (!m_queues.back()->pop(item, m_stop) || item.end)
+        return false;
+    out = item.frame;
+    return true;
+}
+
+bool FilterPipeline::tryPop(cv::Mat& out)
+{
+    Item item;
+    if (!m_queues.back()->tryPop(item) || item.end)
+        return false;
+    out = item.frame;
+    return true;
+}
+
+std::size_t FilterPipeline::inFlight() const
+{
+    std::size_t n = 0;
+    for (const auto& q : m_queues)
+        n += q->sizeApprox();
+    return n;
+}
+
+void FilterPipeline::stageLoop(Stage& stage)
+{
+    Item item;
+    while (stage.in->pop(item, m_stop)) {
+        if (!item.end)
+            runFilters(stage, item);
+
+        const bool end = item.end;
+        if (!stage.out->push(item, m_stop) || end)
+            return;
+    }
+}
+
+void FilterPipeline::runFilters(Stage& stage, Item& item)
+{
+    cv::Mat frame = item.frame;
+    for (const auto& f : stage.filters) {
+        // 与 FilterChain::run 一致：禁用的滤镜不参与，格式从实际输出推断
+        if (!f->enabled())
+            continue;
+        if (!f->accepts(item.fmt)) {
+            cv::Mat bgr = stage.pool.acquire(frame.size(), CV_8UC3);
+            cv::cvtColor(frame, bgr, cv::COLOR_GRAY2BGR);
+            frame    = bgr;
+            item.fmt = FrameFormat::bgr();
+        }
+        const FrameFormat outFmt = f->outputFormat(item.fmt);
+        cv::Mat out = stage.pool.acquire(frame.size(), outFmt.type());
+        f->apply(frame, out);
+        frame    = out;
+        item.fmt = FrameFormat::of(out);
+    }
+
+    if (stage.isLast && item.fmt.isGray()) {
+        cv::Mat bgr = stage.pool.acquire(frame.size(), CV_8UC3);
+        cv::cvtColor(frame, bgr, cv::COLOR_GRAY2BGR);
+        frame    = bgr;
+        item.fmt = FrameFormat::bgr();
+    }
+    item.frame = frame;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "FilterChain.h"
+#include "FramePool.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// 流水线配置：吞吐由最慢一级决定，而非各级耗时之和
+struct PipelineConfig {
+    int stages     = 0;   // 线程级数；0 = 每个启用的滤镜独占一级，多余滤镜按顺序均分到各级
+    int queueDepth = 2;   // 级间队列深度：1 = 最低延迟；越深越能吸收单帧耗时抖动，延迟越高
+};
+
+// 跨帧流水线化的滤镜链（离线文件处理等只关心吞吐的场景）
+// 各级在独立线程上运行，级间以有界 SPSC 队列连接；队列满时对 push 施加反压
+// 输出帧按输入顺序给出，格式统一为 BGR
+// 滤镜在构造时克隆，可与实时 FilterChain 同时使用
+class FilterPipeline {
+public:
+    explicit FilterPipeline(FilterChain::Snapshot filters, PipelineConfig cfg = {});
+    ~FilterPipeline();
+
+    FilterPipeline(const FilterPipeline&)            = delete;
+    FilterPipeline& operator=(const FilterPipeline&) = delete;
+
+    void start();
+
+    // 立即停止所有级（丢弃在途帧）
+    void stop();
+
+    // 投递一帧（仅一个生产者线程）；队列满时阻塞，已停止返回 false
+    bool push(const cv::Mat& frame);
+
+    // 声明输入结束：在途帧处理完后 pop 返回 false
+    void finish();
+
+    // 取出下一帧结果（仅一个消费者线程）；阻塞直到可用，流结束或已停止返回 false
+    bool pop(cv::Mat& out);
+
+    // 非阻塞取出
+    bool tryPop(cv::Mat& out);
+
+    std::size_t stageCount() const { return m_stages.size(); }
+
+    // 当前在途帧数（各级队列之和，近似值）
+    std::size_t inFlight() const;
+
+private:
+    struct Item {
+        cv::Mat     frame;
+        FrameFormat fmt;
+        bool        end = false;   // 流结束标记
+    };
+    using Queue = SpscQueue<Item>;
+
+    struct Stage {
+        std::vector<FilterChain::FilterPtr> filters;
+        bool        isLast = false;
+        Queue*      in     = nullptr;
+        Queue*      out    = nullptr;
+        FramePool   pool;
+        std::thread thread;
+    };
+
+    void stageLoop(Stage& stage);
+    void runFilters(Stage& stage, Item& item);
+
+    PipelineConfig                      m_cfg;
+    std::vector<std::unique_ptr<Queue>> m_queues;   // stages + 1 个
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    std::atomic<bool>                   m_stop{false};
+    bool                                m_started = false;
+};
@@ -0,0 +1,46 @@
+#include "FramePool.h"
+
+FramePool::FramePool(std::size_t capacity)
+    : m_capacity(capacity)
+{
+    m_slots.reserve(capacity);
+}
+
+bool FramePool::isFree(const cv::Mat& slot)
+{
+    return slot.u == nullptr || slot.u->refcount == 1;
+}
+
+cv::Mat FramePool::acquire(cv::Size size, int type)
+{
+    // 1. 空闲且尺寸/类型吻合的槽位：零分配
+    for (auto& slot : m_slots) {
+        if (isFree(slot) && !slot.empty()
+            && slot.size() == size && slot.type() == type)
+            return slot;
+    }
+
+    // 2. 尚有容量：新增槽位
+    //    优先于重建空闲槽位，使交替出现的多种规格（代理/全分辨率）各自常驻，稳态零分配
+    ++m_allocations;
+    if (m_slots.size() < m_capacity) {
+        m_slots.emplace_back(size, type);
+        return m_slots.back();
+    }
+
+    // 3. 池已满且有空闲但规格不符的槽位：原地重建
+    for (auto& slot : m_slots) {
+        if (isFree(slot)) {
+            slot.create(size, type);
+            return slot;
+        }
+    }
+
+    // 4. 全部被下游占用：临时分配，不入池
+    return cv::Mat(size, type);
+}
+
+void FramePool::clear()
+{
+    m_slots.clear();
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <cstddef>
+#include <vector>
+
+// 帧缓冲池：跨帧复用整帧缓冲区，消除滤镜链每帧的堆分配
+// 槽位仅被池自身引用（refcount == 1）时视为空闲；被下游持有的帧不会被覆写
+class FramePool {
+public:
+    explicit FramePool(std::size_t capacity = 4);
+
+    // 取一块 size × type 的缓冲区，内容未定义
+    cv::Mat acquire(cv::Size size, int type);
+
+    // 释放所有槽位（分辨率切换时调用）
+    void clear();
+
+    // 累计分配次数（含池满时的临时分配）
+    std::size_t allocations() const { return m_allocations; }
+
+private:
+    static bool isFree(const cv::Mat& slot);
+
+    std::vector<cv::Mat> m_slots;
+    std::size_t          m_capacity;
+    std::size_t          m_allocations = 0;
+};
@@ -0,0 +1,140 @@
+#include "FusedKernels.h"
+#include "GrayscaleFilter.h"
+#include "ThresholdFilter.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+namespace {
+
+// 带高度：至少 32 行，且 halo 冗余不超过带高的一半
+int bandRows(int halo)
+{
+    return std::max(32, 4 * halo);
+}
+
+template <typename T>
+T* as(FilterBase* f)
+{
+    return dynamic_cast<T*>(f);
+}
+
+// 灰度化 → 高斯 → 固定阈值
+void grayBlurThreshold(const FusedKernels::Plan& plan, const cv::Mat& src, cv::Mat& dst)
+{
+    const int k    = GaussianFilter::effectiveKernelSize(plan.gauss);
+    const int r    = k / 2;
+    const int rows = src.rows;
+    const int band = bandRows(r);
+    const int nBands = (rows + band - 1) / band;
+
+    dst.create(src.size(), CV_8UC1);
+    cv::parallel_for_(cv::Range(0, nBands), [&](const cv::Range& range) {
+        thread_local cv::Mat gray, blurred;
+        for (int b = range.start; b < range.end; ++b) {
+            const int y0 = b * band;
+            const int y1 = std::min(rows, y0 + band);
+            cv::Mat interior;
+
+            if (src.channels() == 1) {
+                // 源帧 ROI 使用非隔离边界，模糊直接读取带外真实邻域
+                cv::GaussianBlur(src.rowRange(y0, y1), blurred, cv::Size(k, k),
+                                 plan.gauss.sigmaX, plan.gauss.sigmaY);
+                interior = blurred;
+            } else {
+                // 灰度中间结果只存在于带缓冲区，带边缘的反射误差落在 halo 内
+                const int a = std::max(0, y0 - r);
+                const int e = std::min(rows, y1 + r);
+                cv::cvtColor(src.rowRange(a, e), gray, cv::COLOR_BGR2GRAY);
+                cv::GaussianBlur(gray, blurred, cv::Size(k, k),
+                                 plan.gauss.sigmaX, plan.gauss.sigmaY);
+                interior = blurred.rowRange(y0 - a, y1 - a);
+            }
+
+            cv::Mat out = dst.rowRange(y0, y1);
+            cv::threshold(interior, out, plan.thresh, 255, cv::THRESH_BINARY);
+        }
+    });
+}
+
+// 高斯（BGR）→ Canny：模糊后的三通道帧不落地，带内直接转灰度
+void blurCanny(const FusedKernels::Plan& plan, const cv::Mat& src, cv::Mat& dst)
+{
+    const int k    = GaussianFilter::effectiveKernelSize(plan.gauss);
+    const int rows = src.rows;
+    const int band = bandRows(k / 2);
+    const int nBands = (rows + band - 1) / band;
+
+    thread_local cv::Mat gray;
+    gray.create(src.size(), CV_8UC1);
+
+    cv::parallel_for_(cv::Range(0, nBands), [&](const cv::Range& range) {
+        thread_local cv::Mat blurred;
+        for (int b = range.start; b < range.end; ++b) {
+            const int y0 = b * band;
+            const int y1 = std::min(rows, y0 + band);
+            cv::GaussianBlur(src.rowRange(y0, y1), blurred, cv::Size(k, k),
+                             plan.gauss.sigmaX, plan.gauss.sigmaY);
+            cv::Mat out = gray.rowRange(y0, y1);
+            cv::cvtColor(blurred, out, cv::COLOR_BGR2GRAY);
+        }
+    });
+
+    // 滞后阈值为整帧连通操作，在完整灰度帧上执行
+    const CannyParams& c = plan.canny;
+    cv::Canny(gray, dst, c.threshold1, c.threshold2, c.apertureSize, c.l2gradient);
+}
+
+} // namespace
+
+namespace FusedKernels {
+
+Plan match(FilterBase* const* filters, std::size_t count, const FrameFormat& in)
+{
+    Plan plan;
+
+    if (count >= 3) {
+        auto* g = as<GrayscaleFilter>(filters[0]);
+        auto* b = as<GaussianFilter>(filters[1]);
+        auto* t = as<ThresholdFilter>(filters[2]);
+        if (g && b && t && !GaussianFilter::usesBoxEngine(b->effectiveParams())) {
+            const ThresholdParams tp = t->params();
+            if (tp.type == ThresholdType::Fixed) {
+                plan.kind   = Kind::GrayBlurThreshold;
+                plan.length = 3;
+                plan.gauss  = b->effectiveParams();
+                plan.thresh = tp.value;
+                return plan;
+            }
+        }
+    }
+
+    if (count >= 2 && !in.isGray() && in.channels == 3) {
+        auto* b = as<GaussianFilter>(filters[0]);
+        auto* c = as<CannyFilter>(filters[1]);
+        if (b && c && !GaussianFilter::usesBoxEngine(b->effectiveParams())) {
+            plan.kind   = Kind::BlurCanny;
+            plan.length = 2;
+            plan.gauss  = b->effectiveParams();
+            plan.canny  = c->params();
+            return plan;
+        }
+    }
+
+    return plan;
+}
+
+void run(const Plan& plan, const cv::Mat& src, cv::Mat& dst)
+{
+    switch (plan.kind) {
+    case Kind::GrayBlurThreshold:
+        grayBlurThreshold(plan, src, dst);
+        break;
+    case Kind::BlurCanny:
+        blurCanny(plan, src, dst);
+        break;
+    case Kind::None:
+        break;
+    }
+}
+
+} // namespace FusedKernels
@@ -0,0 +1,33 @@
+#pragma once
+#include "FilterBase.h"
+#include "GaussianFilter.h"
+#include "CannyFilter.h"
+#include <cstddef>
+
+// 常见滤镜序列的融合执行：按缓存大小的行带（band）一次扫过内存，
+// 中间结果只存在于带缓冲区中，不再整帧写出再读回
+// 每带内部仍调用与独立滤镜完全相同的 OpenCV 内核（已 SIMD 化），结果与未融合链逐位一致
+// 高斯走盒式引擎时不参与融合（盒式引擎本身已与核尺寸无关）
+namespace FusedKernels {
+
+enum class Kind {
+    None,
+    GrayBlurThreshold,   // 灰度化 → 高斯模糊 → 固定阈值二值化
+    BlurCanny,           // 高斯模糊（BGR）→ Canny
+};
+
+struct Plan {
+    Kind           kind   = Kind::None;
+    std::size_t    length = 0;   // 消耗的滤镜个数
+    GaussianParams gauss;
+    CannyParams    canny;
+    double         thresh = 0.0;
+};
+
+// 从 filters[0] 开始匹配已知序列（调用方保证均已启用）；未命中返回 kind == None
+Plan match(FilterBase* const* filters, std::size_t count, const FrameFormat& in);
+
+// 执行融合内核，dst 为 8UC1（尺寸/类型匹配时复用）
+void run(const Plan& plan, const cv::Mat& src, cv::Mat& dst);
+
+} // namespace FusedKernels
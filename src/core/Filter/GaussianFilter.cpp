@@ -1,5 +1,7 @@
 #include "GaussianFilter.h"
 #include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
 
 GaussianFilter::GaussianFilter(GaussianParams p)
     : m_params(p)
@@ -7,33 +9,132 @@ GaussianFilter::GaussianFilter(GaussianParams p)
 
 void GaussianFilter::setParams(GaussianParams p)
 {
-    std::lock_guard<std::mutex> lock(m_mu);
-    m_params = p;
+    m_params.store(p);
 }
 
 GaussianParams GaussianFilter::params() const
 {
-    std::lock_guard<std::mutex> lock(m_mu);
-    return m_params;
+    return m_params.load();
 }
 
-cv::Mat GaussianFilter::apply(const cv::Mat& src)
+GaussianParams GaussianFilter::effectiveParams() const
 {
-    if (!m_enabled)
-        return src.clone();
+    return scaled(m_params.load(), processingScale());
+}
 
-    GaussianParams p;
-    {
-        std::lock_guard<std::mutex> lock(m_mu);
-        p = m_params;
-    }
+GaussianParams GaussianFilter::scaled(const GaussianParams& p, double scale)
+{
+    if (scale == 1.0)
+        return p;
+
+    GaussianParams s = p;
+    const int half = effectiveKernelSize(p) / 2;
+    s.kernelSize = 2 * static_cast<int>(std::lround(half * scale)) + 1;
+    s.sigmaX     = p.sigmaX * scale;
+    s.sigmaY     = p.sigmaY * scale;
+    // Auto 规则按用户设定的核尺寸判定，缩放后不切换引擎
+    if (s.engine == BlurEngine::Auto)
+        s.engine = usesBoxEngine(p) ? BlurEngine::StackedBox : BlurEngine::Exact;
+    return s;
+}
 
+int GaussianFilter::effectiveKernelSize(const GaussianParams& p)
+{
     // 强制奇数化
     int k = p.kernelSize;
     if (k % 2 == 0) k++;
     if (k < 1) k = 1;
+    return k;
+}
+
+bool GaussianFilter::usesBoxEngine(const GaussianParams& p)
+{
+    switch (p.engine) {
+    case BlurEngine::Exact:      return false;
+    case BlurEngine::StackedBox: return true;
+    case BlurEngine::Auto:       break;
+    }
+    return effectiveKernelSize(p) >= p.boxThreshold;
+}
+
+int GaussianFilter::haloRows() const
+{
+    const GaussianParams p = effectiveParams();
+    if (!usesBoxEngine(p))
+        return effectiveKernelSize(p) / 2;
+
+    int halo = 0;
+    for (int w : boxWidthsFor(sigmaOf(p, true)))
+        halo += w / 2;
+    return halo;
+}
+
+void GaussianFilter::applyImpl(const cv::Mat& src, cv::Mat& dst)
+{
+    const GaussianParams p = effectiveParams();
+    if (usesBoxEngine(p))
+        boxBlur(src, dst, p);
+    else
+        exactBlur(src, dst, p);
+}
 
-    cv::Mat dst;
+double GaussianFilter::sigmaOf(const GaussianParams& p, bool yAxis)
+{
+    double s = (yAxis && p.sigmaY > 0.0) ? p.sigmaY : p.sigmaX;
+    if (s <= 0.0) {
+        // 与 cv::getGaussianKernel 相同的由核尺寸推导 sigma 的规则
+        const int k = effectiveKernelSize(p);
+        s = 0.3 * ((k - 1) * 0.5 - 1) + 0.8;
+    }
+    return s;
+}
+
+GaussianFilter::BoxWidths GaussianFilter::boxWidthsFor(double sigma)
+{
+    // n 次宽度为 wl / wu（= wl + 2）的盒式模糊，方差和 = sigma²
+    constexpr int n = kBoxPasses;
+    const double wIdeal = std::sqrt(12.0 * sigma * sigma / n + 1.0);
+    int wl = static_cast<int>(std::floor(wIdeal));
+    if (wl % 2 == 0) wl--;
+    wl = std::max(wl, 1);
+    const int wu = wl + 2;
+
+    const double mIdeal = (12.0 * sigma * sigma - n * wl * wl - 4.0 * n * wl - 3.0 * n)
+                        / (-4.0 * wl - 4.0);
+    const int m = std::max(0, std::min(n, static_cast<int>(std::lround(mIdeal))));
+
+    BoxWidths w{};
+    for (int i = 0; i < n; ++i)
+        w[static_cast<std::size_t>(i)] = (i < m) ? wl : wu;
+    return w;
+}
+
+void GaussianFilter::exactBlur(const cv::Mat& src, cv::Mat& dst, const GaussianParams& p)
+{
+    const int k = effectiveKernelSize(p);
     cv::GaussianBlur(src, dst, cv::Size(k, k), p.sigmaX, p.sigmaY);
-    return dst;
+}
+
+void GaussianFilter::boxBlur(const cv::Mat& src, cv::Mat& dst, const GaussianParams& p)
+{
+    // cv::blur 以滑动和实现，单像素开销与盒宽无关（内部已 SIMD 化）
+    const BoxWidths wx = boxWidthsFor(sigmaOf(p, false));
+    const BoxWidths wy = boxWidthsFor(sigmaOf(p, true));
+
+    thread_local cv::Mat tmp;
+    cv::blur(src, dst, cv::Size(wx[0], wy[0]));
+    cv::blur(dst, tmp, cv::Size(wx[1], wy[1]));
+    cv::blur(tmp, dst, cv::Size(wx[2], wy[2]));
+}
+
+BlurAccuracy GaussianFilter::compareEngines(const cv::Mat& src, const GaussianParams& p)
+{
+    cv::Mat exact, approx;
+    exactBlur(src, exact, p);
+    boxBlur(src, approx, p);
+
+    BlurAccuracy acc;
+    acc.maxAbsDiff = cv::norm(exact, approx, cv::NORM_INF);
+    acc.psnr       = cv::PSNR(exact, approx);
+    return acc;
 }
@@ -1,11 +1,25 @@
 #pragma once
 #include "FilterBase.h"
-#include <mutex>
+#include "AtomicParams.h"
+#include <array>
+
+// 模糊引擎：Exact 为 cv::GaussianBlur，耗时随核尺寸增长；
+// StackedBox 为三次盒式模糊逼近高斯，单像素开销与核尺寸无关
+enum class BlurEngine { Auto, Exact, StackedBox };
 
 struct GaussianParams {
     int    kernelSize = 5;   // 奇数，范围 [1, 31]
     double sigmaX     = 1.0; // 0 = 自动
     double sigmaY     = 0.0; // 0 = 同 sigmaX
+
+    BlurEngine engine       = BlurEngine::Auto;
+    int        boxThreshold = 15;   // Auto：核尺寸 ≥ 该值时改用 StackedBox
+};
+
+// 盒式逼近相对精确核的误差（8U 像素值）
+struct BlurAccuracy {
+    double maxAbsDiff = 0.0;
+    double psnr       = 0.0;   // dB；完全一致时为 OpenCV 约定的 361
 };
 
 class GaussianFilter : public FilterBase {
@@ -14,11 +28,42 @@ public:
     void   setParams(GaussianParams p);
     GaussianParams params() const;
 
+    // 按 processingScale() 缩放后实际生效的参数
+    GaussianParams effectiveParams() const;
+
+    // 将核尺寸与 sigma 按比例缩放（核尺寸保持奇数，sigma 为 0 时仍由核尺寸推导）
+    static GaussianParams scaled(const GaussianParams& p, double scale);
+
+    // 实际使用的核尺寸（强制奇数化，≥ 1）
+    static int effectiveKernelSize(const GaussianParams& p);
+
+    // 按参数（含 Auto 规则）是否走盒式引擎
+    static bool usesBoxEngine(const GaussianParams& p);
+
+    // 在 src 上分别运行两种引擎并比较结果（用于校验/调参，非实时路径；误差上界见 tests/GaussianEngineTest）
+    static BlurAccuracy compareEngines(const cv::Mat& src, const GaussianParams& p);
+
     std::string id()   const override { return "gaussian"; }
     std::string name() const override { return "高斯模糊"; }
-    cv::Mat apply(const cv::Mat& src) override;
+
+    // 任意通道数均可直接模糊，灰度输入只处理单通道
+    bool accepts(const FrameFormat&) const override { return true; }
+    int  haloRows() const override;   // 核半径（盒式引擎为各次盒宽半径之和）
+
+    std::shared_ptr<FilterBase> clone() const override { return std::make_shared<GaussianFilter>(params()); }
+
+protected:
+    void applyImpl(const cv::Mat& src, cv::Mat& dst) override;
 
 private:
-    GaussianParams     m_params;
-    mutable std::mutex m_mu;
+    static constexpr int kBoxPasses = 3;
+    using BoxWidths = std::array<int, kBoxPasses>;
+
+    // 给定 sigma 的三次盒宽（奇数），方差之和等于 sigma²
+    static BoxWidths boxWidthsFor(double sigma);
+    static double    sigmaOf(const GaussianParams& p, bool yAxis);
+    static void      exactBlur(const cv::Mat& src, cv::Mat& dst, const GaussianParams& p);
+    static void      boxBlur(const cv::Mat& src, cv::Mat& dst, const GaussianParams& p);
+
+    AtomicParams<GaussianParams> m_params;
 };
@@ -1,13 +1,11 @@
 #include "GrayscaleFilter.h"
 #include <opencv2/imgproc.hpp>
 
-cv::Mat GrayscaleFilter::apply(const cv::Mat& src)
+void GrayscaleFilter::applyImpl(const cv::Mat& src, cv::Mat& dst)
 {
-    if (!m_enabled)
-        return src.clone();
-
-    cv::Mat gray, bgr;
-    cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
-    cv::cvtColor(gray, bgr, cv::COLOR_GRAY2BGR);
-    return bgr;
+    if (src.channels() == 1) {
+        src.copyTo(dst);
+        return;
+    }
+    cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY);
 }
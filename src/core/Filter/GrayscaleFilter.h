@@ -5,5 +5,14 @@ class GrayscaleFilter : public FilterBase {
 public:
     std::string id()   const override { return "grayscale"; }
     std::string name() const override { return "灰度化"; }
-    cv::Mat apply(const cv::Mat& src) override;
+
+    // 输出原生 8UC1，不再转回 BGR
+    bool accepts(const FrameFormat&) const override { return true; }
+    FrameFormat outputFormat(const FrameFormat&) const override { return FrameFormat::gray(); }
+    int haloRows() const override { return 0; }   // 逐像素
+
+    std::shared_ptr<FilterBase> clone() const override { return std::make_shared<GrayscaleFilter>(); }
+
+protected:
+    void applyImpl(const cv::Mat& src, cv::Mat& dst) override;
 };
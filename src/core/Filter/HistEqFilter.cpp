@@ -7,39 +7,88 @@ HistEqFilter::HistEqFilter(HistEqParams p)
 
 void HistEqFilter::setParams(HistEqParams p)
 {
-    std::lock_guard<std::mutex> lock(m_mu);
-    m_params = p;
+    m_params.store(p);
 }
 
-cv::Mat HistEqFilter::apply(const cv::Mat& src)
+HistEqParams HistEqFilter::params() const
 {
-    if (!m_enabled)
-        return src.clone();
+    return m_params.load();
+}
+
+void HistEqFilter::applyImpl(const cv::Mat& src, cv::Mat& dst)
+{
+    const HistEqParams p = m_params.load();
+
+    auto equalize = [this, &p](const cv::Mat& in, cv::Mat& out) {
+        if (p.useCLAHE) {
+            // 均衡器对象跨帧复用，仅更新参数
+            if (!m_clahe)
+                m_clahe = cv::createCLAHE();
+            m_clahe->setClipLimit(p.clipLimit);
+            m_clahe->setTilesGridSize(cv::Size(p.tileGridW, p.tileGridH));
+            m_clahe->apply(in, out);
+        } else {
+            cv::equalizeHist(in, out);
+        }
+    };
 
-    HistEqParams p;
-    {
-        std::lock_guard<std::mutex> lock(m_mu);
-        p = m_params;
+    if (p.useCLAHE && p.temporal) {
+        applyTemporal(p, src, dst);
+        return;
     }
 
-    // 转 YCrCb，对 Y 通道做均衡化，再转回 BGR
-    cv::Mat ycrcb;
-    cv::cvtColor(src, ycrcb, cv::COLOR_BGR2YCrCb);
+    if (src.channels() == 1) {
+        equalize(src, dst);
+        return;
+    }
 
-    std::vector<cv::Mat> channels;
+    // 转 YCrCb，对 Y 通道做均衡化，再转回 BGR（中间缓冲区跨帧复用）
+    thread_local cv::Mat ycrcb;
+    thread_local std::vector<cv::Mat> channels;
+    cv::cvtColor(src, ycrcb, cv::COLOR_BGR2YCrCb);
     cv::split(ycrcb, channels);
+    equalize(channels[0], channels[0]);
+    cv::merge(channels, ycrcb);
+    cv::cvtColor(ycrcb, dst, cv::COLOR_YCrCb2BGR);
+}
+
+void HistEqFilter::applyTemporal(const HistEqParams& p, const cv::Mat& src, cv::Mat& dst)
+{
+    TemporalClahe::Config cfg;
+    cfg.clipLimit       = p.clipLimit;
+    cfg.tilesX          = p.tileGridW;
+    cfg.tilesY          = p.tileGridH;
+    cfg.refreshInterval = p.refreshInterval;
+    cfg.changeThreshold = p.changeThreshold;
+
+    TemporalState& state = temporalFor(src.size());
 
-    if (p.useCLAHE) {
-        auto clahe = cv::createCLAHE(p.clipLimit,
-                                     cv::Size(p.tileGridW, p.tileGridH));
-        clahe->apply(channels[0], channels[0]);
-    } else {
-        cv::equalizeHist(channels[0], channels[0]);
+    // 灰度：拷入 dst 后原地处理；BGR：在交错的 YCrCb 缓冲区上只改 Y 通道
+    if (src.channels() == 1) {
+        src.copyTo(dst);
+        state.clahe.apply(dst, 0, cfg);
+        return;
     }
 
-    cv::merge(channels, ycrcb);
+    cv::cvtColor(src, state.ycrcb, cv::COLOR_BGR2YCrCb);
+    state.clahe.apply(state.ycrcb, 0, cfg);
+    cv::cvtColor(state.ycrcb, dst, cv::COLOR_YCrCb2BGR);
+}
 
-    cv::Mat bgr;
-    cv::cvtColor(ycrcb, bgr, cv::COLOR_YCrCb2BGR);
-    return bgr;
+HistEqFilter::TemporalState& HistEqFilter::temporalFor(cv::Size size)
+{
+    // 命中同尺寸状态；否则复用最久未用的一份（重置其 LUT 缓存）
+    TemporalState* victim = &m_temporal[0];
+    for (auto& s : m_temporal) {
+        if (s.size == size) {
+            s.lastUse = ++m_temporalTick;
+            return s;
+        }
+        if (s.lastUse < victim->lastUse)
+            victim = &s;
+    }
+    victim->size = size;
+    victim->clahe.reset();
+    victim->lastUse = ++m_temporalTick;
+    return *victim;
 }
@@ -1,24 +1,57 @@
 #pragma once
 #include "FilterBase.h"
-#include <mutex>
+#include "AtomicParams.h"
+#include "TemporalClahe.h"
+#include <opencv2/imgproc.hpp>
+#include <array>
+#include <cstdint>
 
 struct HistEqParams {
     bool   useCLAHE  = true;
     double clipLimit = 2.0;
     int    tileGridW = 8;
     int    tileGridH = 8;
+
+    // 时域 CLAHE：跨帧复用 tile 查找表（光照缓变的视频场景）
+    bool   temporal        = false;
+    int    refreshInterval = 30;    // 每 N 帧全量重算
+    double changeThreshold = 4.0;   // 其余帧仅重算亮度均值变化超过该值的 tile
 };
 
 class HistEqFilter : public FilterBase {
 public:
     explicit HistEqFilter(HistEqParams p = {});
     void setParams(HistEqParams p);
+    HistEqParams params() const;
 
     std::string id()   const override { return "histeq"; }
     std::string name() const override { return "CLAHE 均衡化"; }
-    cv::Mat apply(const cv::Mat& src) override;
+
+    // 灰度输入直接均衡化，无需 YCrCb 往返
+    bool accepts(const FrameFormat&) const override { return true; }
+    bool degradable() const override { return true; }
+
+    std::shared_ptr<FilterBase> clone() const override { return std::make_shared<HistEqFilter>(params()); }
+
+protected:
+    void applyImpl(const cv::Mat& src, cv::Mat& dst) override;
 
 private:
-    HistEqParams       m_params;
-    mutable std::mutex m_mu;
+    // 时域状态按分辨率分开保存：代理预览与全分辨率录制交替处理时互不覆盖 LUT
+    struct TemporalState {
+        cv::Size      size;
+        TemporalClahe clahe;
+        cv::Mat       ycrcb;         // BGR 输入的交错 YCrCb 缓冲区，跨帧复用
+        std::uint64_t lastUse = 0;
+    };
+    static constexpr std::size_t kTemporalStates = 2;
+
+    void           applyTemporal(const HistEqParams& p, const cv::Mat& src, cv::Mat& dst);
+    TemporalState& temporalFor(cv::Size size);
+
+    AtomicParams<HistEqParams> m_params;
+    // 以下状态仅帧线程访问（整帧滤镜，不参与条带并行）
+    cv::Ptr<cv::CLAHE>         m_clahe;
+    std::array<TemporalState, kTemporalStates> m_temporal;
+    std::uint64_t              m_temporalTick = 0;
 };
@@ -0,0 +1,197 @@
+#include "TemporalClahe.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kBins = 256;
+constexpr int kSampleStep = 4;   // 变化检测的采样步长（行/列）
+
+// BORDER_REFLECT_101：扩展区的坐标映射回图像内（扩展宽度不超过 tile 数；极小图像钳制到 0）
+inline int reflect101(int i, int n)
+{
+    return i < n ? i : std::max(2 * (n - 1) - i, 0);
+}
+
+// 与 cv::CLAHE 相同：任一方向不能整除时两个方向都扩展 tiles - (n % tiles)
+cv::Size extendedTileSize(cv::Size size, int tilesX, int tilesY)
+{
+    if (size.width % tilesX == 0 && size.height % tilesY == 0)
+        return { size.width / tilesX, size.height / tilesY };
+    return { (size.width + tilesX - size.width % tilesX) / tilesX,
+             (size.height + tilesY - size.height % tilesY) / tilesY };
+}
+}
+
+void TemporalClahe::reset()
+{
+    m_valid = false;
+    m_frame = 0;
+}
+
+void TemporalClahe::apply(cv::Mat& img, int channel, const Config& cfg)
+{
+    CV_Assert(img.depth() == CV_8U && channel < img.channels());
+
+    Geometry geom;
+    geom.size      = img.size();
+    geom.tilesX    = std::max(1, std::min(cfg.tilesX, img.cols));
+    geom.tilesY    = std::max(1, std::min(cfg.tilesY, img.rows));
+    geom.clipLimit = cfg.clipLimit;
+    const cv::Size tile = extendedTileSize(geom.size, geom.tilesX, geom.tilesY);
+    geom.tileW     = tile.width;
+    geom.tileH     = tile.height;
+
+    const bool rebuild = !m_valid || !(geom == m_geom);
+    if (rebuild) {
+        m_geom = geom;
+        m_luts.create(geom.tilesY * geom.tilesX, kBins, CV_8U);
+        m_tileMeans.assign(static_cast<std::size_t>(geom.tilesY * geom.tilesX), -1.f);
+        prepareInterpolation();
+        m_frame = 0;
+    }
+
+    const bool full = rebuild || cfg.refreshInterval <= 1
+                   || (m_frame % static_cast<std::uint64_t>(cfg.refreshInterval)) == 0;
+
+    m_lastRecomputed = 0;
+    for (int ty = 0; ty < m_geom.tilesY; ++ty) {
+        for (int tx = 0; tx < m_geom.tilesX; ++tx) {
+            const std::size_t idx = static_cast<std::size_t>(ty * m_geom.tilesX + tx);
+            const float mean = sampleMean(img, channel, tx, ty);
+            if (!full && std::abs(mean - m_tileMeans[idx]) <= cfg.changeThreshold)
+                continue;
+            buildLut(img, channel, tx, ty);
+            m_tileMeans[idx] = mean;
+            ++m_lastRecomputed;
+        }
+    }
+
+    interpolate(img, channel);
+    m_valid = true;
+    ++m_frame;
+}
+
+float TemporalClahe::sampleMean(const cv::Mat& img, int channel, int tx, int ty) const
+{
+    // 仅采样图像内的像素
+    const int x0 = tx * m_geom.tileW, x1 = std::min(x0 + m_geom.tileW, img.cols);
+    const int y0 = ty * m_geom.tileH, y1 = std::min(y0 + m_geom.tileH, img.rows);
+    const int cn = img.channels();
+
+    std::uint64_t sum = 0, n = 0;
+    for (int y = y0; y < y1; y += kSampleStep) {
+        const uchar* row = img.ptr<uchar>(y);
+        for (int x = x0; x < x1; x += kSampleStep) {
+            sum += row[x * cn + channel];
+            ++n;
+        }
+    }
+    return n ? static_cast<float>(sum) / static_cast<float>(n) : 0.f;
+}
+
+void TemporalClahe::buildLut(const cv::Mat& img, int channel, int tx, int ty)
+{
+    // tile 在扩展图像中的范围；超出图像的行/列按 BORDER_REFLECT_101 取样
+    const int x0 = tx * m_geom.tileW, x1 = x0 + m_geom.tileW;
+    const int y0 = ty * m_geom.tileH, y1 = y0 + m_geom.tileH;
+    const int xIn = std::min(x1, img.cols);
+    const int cn = img.channels();
+    const int area = m_geom.tileW * m_geom.tileH;
+
+    int hist[kBins] = {0};
+    for (int y = y0; y < y1; ++y) {
+        const uchar* row = img.ptr<uchar>(reflect101(y, img.rows)) + channel;
+        for (int x = x0; x < xIn; ++x)
+            ++hist[row[x * cn]];
+        for (int x = xIn; x < x1; ++x)
+            ++hist[row[reflect101(x, img.cols) * cn]];
+    }
+
+    // 裁剪并均匀回填超出部分（与 cv::CLAHE 相同的规则，clipLimit ≤ 0 时不裁剪）
+    if (m_geom.clipLimit > 0.0) {
+        const int clip = std::max(static_cast<int>(m_geom.clipLimit * area / kBins), 1);
+        int clipped = 0;
+        for (int& h : hist) {
+            if (h > clip) {
+                clipped += h - clip;
+                h = clip;
+            }
+        }
+        const int batch = clipped / kBins;
+        int residual    = clipped - batch * kBins;
+        for (int& h : hist)
+            h += batch;
+        if (residual > 0) {
+            const int step = std::max(kBins / residual, 1);
+            for (int i = 0; i < kBins && residual > 0; i += step, --residual)
+                ++hist[i];
+        }
+    }
+
+    uchar* lut = m_luts.ptr<uchar>(ty * m_geom.tilesX + tx);
+    const float scale = 255.f / static_cast<float>(area);
+    int cdf = 0;
+    for (int i = 0; i < kBins; ++i) {
+        cdf += hist[i];
+        lut[i] = cv::saturate_cast<uchar>(static_cast<float>(cdf) * scale);
+    }
+}
+
+void TemporalClahe::prepareInterpolation()
+{
+    // 以 tile 中心为插值节点；边缘处两侧索引钳制到同一 tile，权重不截断（与 cv::CLAHE 相同）
+    auto build = [](int n, int tiles, int tileSize, std::vector<int>& idx1, std::vector<int>& idx2,
+                    std::vector<float>& w1, std::vector<float>& w2) {
+        const auto count = static_cast<std::size_t>(n);
+        idx1.resize(count);
+        idx2.resize(count);
+        w1.resize(count);
+        w2.resize(count);
+        const float inv = 1.0f / static_cast<float>(tileSize);
+        for (int i = 0; i < n; ++i) {
+            const float t  = static_cast<float>(i) * inv - 0.5f;
+            const int   t1 = cvFloor(t);
+            const auto  k  = static_cast<std::size_t>(i);
+            w2[k]   = t - static_cast<float>(t1);
+            w1[k]   = 1.0f - w2[k];
+            idx1[k] = std::max(t1, 0);
+            idx2[k] = std::min(t1 + 1, tiles - 1);
+        }
+    };
+    build(m_geom.size.width, m_geom.tilesX, m_geom.tileW,
+          m_colTile1, m_colTile2, m_colWeight1, m_colWeight2);
+    build(m_geom.size.height, m_geom.tilesY, m_geom.tileH,
+          m_rowTile1, m_rowTile2, m_rowWeight1, m_rowWeight2);
+}
+
+void TemporalClahe::interpolate(cv::Mat& img, int channel) const
+{
+    const int cn    = img.channels();
+    const int cols  = img.cols;
+    const int tiles = m_geom.tilesX;
+
+    cv::parallel_for_(cv::Range(0, img.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; ++y) {
+            const auto   ry  = static_cast<std::size_t>(y);
+            const float  ya1 = m_rowWeight1[ry];
+            const float  ya  = m_rowWeight2[ry];
+            const uchar* top = m_luts.ptr<uchar>(m_rowTile1[ry] * tiles);
+            const uchar* bot = m_luts.ptr<uchar>(m_rowTile2[ry] * tiles);
+
+            uchar* row = img.ptr<uchar>(y) + channel;
+            for (int x = 0; x < cols; ++x) {
+                const auto  cx  = static_cast<std::size_t>(x);
+                const int   v   = row[x * cn];
+                const int   i1  = m_colTile1[cx] * kBins + v;
+                const int   i2  = m_colTile2[cx] * kBins + v;
+                const float xa1 = m_colWeight1[cx];
+                const float xa  = m_colWeight2[cx];
+
+                // 运算顺序与 cv::CLAHE 一致，保证逐像素相同
+                const float res = (top[i1] * xa1 + top[i2] * xa) * ya1
+                                + (bot[i1] * xa1 + bot[i2] * xa) * ya;
+                row[x * cn] = cv::saturate_cast<uchar>(res);
+            }
+        }
+    });
+}
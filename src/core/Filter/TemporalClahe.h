@@ -0,0 +1,67 @@
+#pragma once
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <vector>
+
+// 跨帧缓存的 CLAHE：各 tile 的查找表在帧间保留，
+// 仅每 refreshInterval 帧整体重算一次，其余帧只重算内容明显变化的 tile
+// 直接在交错存储的某一通道上原地处理（如 YCrCb 的 Y），无需 split/merge
+// tile 划分、裁剪与插值与 cv::CLAHE 一致：全量重算的帧与 cv::createCLAHE()->apply 逐像素相同
+// 有状态，不可重入：同一实例只能由一个线程按帧顺序调用
+class TemporalClahe {
+public:
+    struct Config {
+        double clipLimit       = 2.0;   // ≤ 0 表示不裁剪（同 cv::CLAHE）
+        int    tilesX          = 8;
+        int    tilesY          = 8;
+        int    refreshInterval = 30;    // 强制全量重算的帧间隔（≤ 1 表示每帧重算）
+        double changeThreshold = 4.0;   // tile 亮度均值变化超过该值才重算其直方图
+    };
+
+    // 对 img 的第 channel 个通道原地均衡化（img 为 8U，1 或多通道交错）
+    void apply(cv::Mat& img, int channel, const Config& cfg);
+
+    // 丢弃缓存（切换输入源时调用）
+    void reset();
+
+    // 最近一帧重算的 tile 数（供调参/统计）
+    int lastRecomputedTiles() const { return m_lastRecomputed; }
+
+private:
+    // 尺寸不能被 tile 数整除时，cv::CLAHE 以 BORDER_REFLECT_101 向右/下扩展后均分；
+    // tileW/tileH 为扩展后的 tile 尺寸，超出图像的部分按镜像取样
+    struct Geometry {
+        cv::Size size;
+        int      tilesX = 0;
+        int      tilesY = 0;
+        int      tileW  = 0;
+        int      tileH  = 0;
+        double   clipLimit = 0.0;
+        bool operator==(const Geometry& o) const
+        {
+            return size == o.size && tilesX == o.tilesX && tilesY == o.tilesY
+                && clipLimit == o.clipLimit;
+        }
+    };
+
+    float sampleMean(const cv::Mat& img, int channel, int tx, int ty) const;
+    void  buildLut(const cv::Mat& img, int channel, int tx, int ty);
+    void  prepareInterpolation();
+    void  interpolate(cv::Mat& img, int channel) const;
+
+    Geometry             m_geom;
+    cv::Mat              m_luts;        // (tilesY*tilesX) × 256，CV_8U
+    std::vector<float>   m_tileMeans;   // 构建 LUT 时的 tile 亮度均值
+    // 插值表：每列/每行两侧 tile 索引与权重（权重按 cv::CLAHE 的浮点表达式预计算）
+    std::vector<int>     m_colTile1;
+    std::vector<int>     m_colTile2;
+    std::vector<float>   m_colWeight1;  // 左侧 tile 权重
+    std::vector<float>   m_colWeight2;  // 右侧 tile 权重
+    std::vector<int>     m_rowTile1;
+    std::vector<int>     m_rowTile2;
+    std::vector<float>   m_rowWeight1;
+    std::vector<float>   m_rowWeight2;
+    std::uint64_t        m_frame = 0;
+    bool                 m_valid = false;
+    int                  m_lastRecomputed = 0;
+};
@@ -1,5 +1,53 @@
 #include "ThresholdFilter.h"
 #include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+// 融合路径的行带高度：一带 BGR 行灰度化后立即阈值化，灰度行仍在缓存中
+constexpr int kBandRows = 32;
+
+// 窗口均值/方差查询：积分图为 (rows+1)×(cols+1)，边界处窗口按实际像素数裁剪
+template <typename SumT>
+void integralRows(const cv::Mat& gray, cv::Mat& dst, const cv::Mat& sum, const cv::Mat& sqsum,
+                  const ThresholdParams& p, int half, const cv::Range& range)
+{
+    const int  cols    = gray.cols;
+    const int  rows    = gray.rows;
+    const bool sauvola = (p.type == ThresholdType::Sauvola);
+
+    for (int y = range.start; y < range.end; ++y) {
+        const int y0 = std::max(0, y - half);
+        const int y1 = std::min(rows, y + half + 1);
+        const SumT*   s0 = sum.ptr<SumT>(y0);
+        const SumT*   s1 = sum.ptr<SumT>(y1);
+        const double* q0 = sauvola ? sqsum.ptr<double>(y0) : nullptr;
+        const double* q1 = sauvola ? sqsum.ptr<double>(y1) : nullptr;
+        const uchar*  in  = gray.ptr<uchar>(y);
+        uchar*        out = dst.ptr<uchar>(y);
+
+        for (int x = 0; x < cols; ++x) {
+            const int    x0 = std::max(0, x - half);
+            const int    x1 = std::min(cols, x + half + 1);
+            const double n  = static_cast<double>((x1 - x0) * (y1 - y0));
+            const double m  = static_cast<double>(s1[x1] - s1[x0] - s0[x1] + s0[x0]) / n;
+
+            double t;
+            if (sauvola) {
+                const double sq  = (q1[x1] - q1[x0] - q0[x1] + q0[x0]) / n;
+                const double var = std::max(0.0, sq - m * m);
+                t = m * (1.0 + p.k * (std::sqrt(var) / p.R - 1.0));
+            } else {
+                t = m - p.C;
+            }
+            out[x] = (in[x] > t) ? 255 : 0;
+        }
+    }
+}
+
+} // namespace
 
 ThresholdFilter::ThresholdFilter(ThresholdParams p)
     : m_params(p)
@@ -7,41 +55,127 @@ ThresholdFilter::ThresholdFilter(ThresholdParams p)
 
 void ThresholdFilter::setParams(ThresholdParams p)
 {
-    std::lock_guard<std::mutex> lock(m_mu);
-    m_params = p;
+    m_params.store(p);
+}
+
+ThresholdParams ThresholdFilter::params() const
+{
+    return m_params.load();
+}
+
+ThresholdParams ThresholdFilter::effectiveParams() const
+{
+    ThresholdParams p = m_params.load();
+    const double scale = processingScale();
+    if (scale != 1.0) {
+        const int half = blockSizeOf(p) / 2;
+        p.blockSize = 2 * static_cast<int>(std::lround(half * scale)) + 1;
+    }
+    return p;
+}
+
+int ThresholdFilter::haloRows() const
+{
+    const ThresholdParams p = effectiveParams();
+    switch (p.type) {
+    case ThresholdType::Fixed:    return 0;
+    case ThresholdType::Adaptive:
+    case ThresholdType::AdaptiveMean:
+    case ThresholdType::Sauvola:  return blockSizeOf(p) / 2;
+    case ThresholdType::Otsu:     break;
+    }
+    return kFullFrame;
+}
+
+int ThresholdFilter::blockSizeOf(const ThresholdParams& p)
+{
+    int bs = p.blockSize;
+    if (bs % 2 == 0) bs++;
+    if (bs < 3) bs = 3;
+    return bs;
 }
 
-cv::Mat ThresholdFilter::apply(const cv::Mat& src)
+void ThresholdFilter::applyImpl(const cv::Mat& src, cv::Mat& dst)
 {
-    if (!m_enabled)
-        return src.clone();
+    const ThresholdParams p = effectiveParams();
 
-    ThresholdParams p;
-    {
-        std::lock_guard<std::mutex> lock(m_mu);
-        p = m_params;
+    // 全局阈值的 BGR 输入走融合路径
+    if (src.channels() == 3) {
+        if (p.type == ThresholdType::Fixed) {
+            fusedFixed(src, dst, p.value);
+            return;
+        }
+        if (p.type == ThresholdType::Otsu) {
+            fusedOtsu(src, dst);
+            return;
+        }
     }
 
-    cv::Mat gray, thresh, bgr;
-    cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+    thread_local cv::Mat grayBuf;
+    cv::Mat gray = src;
+    if (src.channels() != 1) {
+        cv::cvtColor(src, grayBuf, cv::COLOR_BGR2GRAY);
+        gray = grayBuf;
+    }
 
     switch (p.type) {
     case ThresholdType::Fixed:
-        cv::threshold(gray, thresh, p.value, 255, cv::THRESH_BINARY);
+        cv::threshold(gray, dst, p.value, 255, cv::THRESH_BINARY);
         break;
-    case ThresholdType::Adaptive: {
-        int bs = p.blockSize;
-        if (bs % 2 == 0) bs++;
-        if (bs < 3) bs = 3;
-        cv::adaptiveThreshold(gray, thresh, 255,
-            cv::ADAPTIVE_THRESH_GAUSSIAN_C, cv::THRESH_BINARY, bs, p.C);
+    case ThresholdType::Adaptive:
+        cv::adaptiveThreshold(gray, dst, 255,
+            cv::ADAPTIVE_THRESH_GAUSSIAN_C, cv::THRESH_BINARY, blockSizeOf(p), p.C);
         break;
-    }
     case ThresholdType::Otsu:
-        cv::threshold(gray, thresh, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+        cv::threshold(gray, dst, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+        break;
+    case ThresholdType::AdaptiveMean:
+    case ThresholdType::Sauvola:
+        integralThreshold(gray, dst, p);
         break;
     }
+}
+
+void ThresholdFilter::fusedFixed(const cv::Mat& bgr, cv::Mat& dst, double thresh)
+{
+    // 灰度化直接用 cvtColor（与通用路径逐位一致，且走 OpenCV 的 SIMD 实现），
+    // 按行带写入 dst 后原地阈值化，不生成整帧中间灰度图
+    dst.create(bgr.size(), CV_8UC1);
+
+    cv::parallel_for_(cv::Range(0, bgr.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y += kBandRows) {
+            const int end = std::min(range.end, y + kBandRows);
+            cv::Mat band = dst.rowRange(y, end);
+            cv::cvtColor(bgr.rowRange(y, end), band, cv::COLOR_BGR2GRAY);
+            cv::threshold(band, band, thresh, 255, cv::THRESH_BINARY);
+        }
+    });
+}
+
+void ThresholdFilter::fusedOtsu(const cv::Mat& bgr, cv::Mat& dst)
+{
+    // Otsu 需要整帧直方图：灰度写入 dst，再在 dst 上原地求阈值并二值化
+    cv::cvtColor(bgr, dst, cv::COLOR_BGR2GRAY);
+    cv::threshold(dst, dst, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+}
+
+void ThresholdFilter::integralThreshold(const cv::Mat& gray, cv::Mat& dst, const ThresholdParams& p)
+{
+    // 积分图缓冲区跨帧复用；像素总和可能溢出 int 时改用 double
+    thread_local cv::Mat sum, sqsum;
+    const bool wide    = gray.total() * 255.0 > static_cast<double>(INT_MAX);
+    const int  sdepth  = wide ? CV_64F : CV_32S;
+    if (p.type == ThresholdType::Sauvola)
+        cv::integral(gray, sum, sqsum, sdepth, CV_64F);
+    else
+        cv::integral(gray, sum, sdepth);
 
-    cv::cvtColor(thresh, bgr, cv::COLOR_GRAY2BGR);
-    return bgr;
+    const int half = blockSizeOf(p) / 2;
+    dst.create(gray.size(), CV_8UC1);
+    cv::parallel_for_(cv::Range(0, gray.rows), [&](const cv::Range& range) {
+        if (wide)
+            integralRows<double>(gray, dst, sum, sqsum, p, half, range);
+        else
+            integralRows<int>(gray, dst, sum, sqsum, p, half, range);
+    });
 }
@@ -1,26 +1,50 @@
 #pragma once
 #include "FilterBase.h"
-#include <mutex>
+#include "AtomicParams.h"
 
-enum class ThresholdType { Fixed, Adaptive, Otsu };
+// AdaptiveMean / Sauvola 基于积分图，单像素开销与 blockSize 无关
+enum class ThresholdType { Fixed, Adaptive, Otsu, AdaptiveMean, Sauvola };
 
 struct ThresholdParams {
     ThresholdType type      = ThresholdType::Fixed;
     double        value     = 127.0;  // Fixed 阈值
-    int           blockSize = 11;     // Adaptive 邻域大小（奇数）
-    double        C         = 2.0;    // Adaptive 常数
+    int           blockSize = 11;     // Adaptive / AdaptiveMean / Sauvola 邻域大小（奇数）
+    double        C         = 2.0;    // Adaptive / AdaptiveMean 常数
+    double        k         = 0.2;    // Sauvola 灵敏度
+    double        R         = 128.0;  // Sauvola 标准差动态范围
 };
 
 class ThresholdFilter : public FilterBase {
 public:
     explicit ThresholdFilter(ThresholdParams p = {});
     void setParams(ThresholdParams p);
+    ThresholdParams params() const;
+
+    // 按 processingScale() 缩放邻域大小后实际生效的参数
+    ThresholdParams effectiveParams() const;
 
     std::string id()   const override { return "threshold"; }
     std::string name() const override { return "二值化"; }
-    cv::Mat apply(const cv::Mat& src) override;
+
+    bool accepts(const FrameFormat&) const override { return true; }
+    FrameFormat outputFormat(const FrameFormat&) const override { return FrameFormat::gray(); }
+    int haloRows() const override;   // Otsu 需整帧直方图
+
+    std::shared_ptr<FilterBase> clone() const override { return std::make_shared<ThresholdFilter>(params()); }
+
+protected:
+    void applyImpl(const cv::Mat& src, cv::Mat& dst) override;
 
 private:
-    ThresholdParams    m_params;
-    mutable std::mutex m_mu;
+    static int  blockSizeOf(const ThresholdParams& p);
+
+    // BGR 输入：灰度直接写入 dst 后原地阈值化（Fixed 按行带进行），不生成中间灰度帧；
+    // 灰度化用 cvtColor，结果与通用路径逐位一致
+    static void fusedFixed(const cv::Mat& bgr, cv::Mat& dst, double thresh);
+    static void fusedOtsu(const cv::Mat& bgr, cv::Mat& dst);
+
+    // 积分图自适应阈值（gray 为 8UC1）
+    static void integralThreshold(const cv::Mat& gray, cv::Mat& dst, const ThresholdParams& p);
+
+    AtomicParams<ThresholdParams> m_params;
 };
@@ -0,0 +1,142 @@
+#include "PipelineScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kEmaAlpha     = 0.1;
+constexpr double kReanchorMsec = 500.0;   // 落后超过该值时放弃追赶，按当前帧重新对齐
+
+} // namespace
+
+PipelineScheduler::Scope::~Scope()
+{
+    m_sched.record(m_stage, msecBetween(m_start, Clock::now()));
+}
+
+double PipelineScheduler::msecBetween(Clock::time_point a, Clock::time_point b)
+{
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+void PipelineScheduler::reset(double fps)
+{
+    if (fps <= 0.0 || fps > 240.0)
+        fps = 30.0;
+    m_periodMsec     = 1000.0 / fps;
+    m_degradeHold    = 0;
+    m_detectDeferred = 0;
+    reanchor();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_timings = PipelineTimings{};
+    m_timings.periodMsec = m_periodMsec;
+}
+
+void PipelineScheduler::reanchor()
+{
+    m_anchored = false;
+    m_lastPts  = -1.0;
+    m_nextDue  = Clock::now();
+}
+
+FramePlan PipelineScheduler::beginFrame(double ptsMsec, bool detectBusy)
+{
+    const auto now    = Clock::now();
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(m_periodMsec));
+
+    // 本帧截止时刻：文件源 = 锚点 + 时间戳偏移；实时源 = 上一帧给出的节拍
+    if (ptsMsec >= 0.0) {
+        if (!m_anchored || ptsMsec < m_lastPts) {
+            m_anchorWall = now;
+            m_anchorPts  = ptsMsec;
+            m_anchored   = true;
+        }
+        m_deadline = m_anchorWall + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>(ptsMsec - m_anchorPts));
+        if (msecBetween(m_deadline, now) > kReanchorMsec) {
+            m_anchorWall = now;
+            m_anchorPts  = ptsMsec;
+            m_deadline   = now;
+        }
+        m_lastPts = ptsMsec;
+    } else {
+        m_deadline = m_anchored ? m_nextDue : now;
+        if (msecBetween(m_deadline, now) > kReanchorMsec)
+            m_deadline = now;
+        m_anchored = true;
+    }
+    m_nextDue = m_deadline + period;
+
+    FramePlan plan;
+    plan.budgetMsec = msecBetween(now, m_nextDue);
+
+    StageTiming filter, detect, render, sink;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        filter = stage(PipelineStage::Filter);
+        detect = stage(PipelineStage::Detect);
+        render = stage(PipelineStage::Render);
+        sink   = stage(PipelineStage::Sink);
+    }
+    // 帧线程上的检测阶段只有门控与跟踪，随帧必跑，计入所需时间
+    const double required = filter.avgMsec + detect.avgMsec + render.avgMsec + sink.avgMsec;
+
+    // 检测：推理线程忙时提交只会在邮箱中等待并被后续帧覆盖，推迟到其空闲后提交最新帧；
+    // 连续推迟达到上限则强制提交，推理线程长期繁忙时检测也不会饿死
+    plan.runDetect = !detectBusy || m_detectDeferred >= kMaxDetectDeferrals;
+
+    // 滤镜：预计超出本帧预算时降级；降级后保持若干帧再尝试恢复
+    if (m_degradeHold > 0) {
+        --m_degradeHold;
+        plan.degradeFilters = true;
+    } else if (required > plan.budgetMsec) {
+        m_degradeHold       = kDegradeHoldFrames;
+        plan.degradeFilters = true;
+    }
+    return plan;
+}
+
+void PipelineScheduler::endFrame()
+{
+    const bool late = Clock::now() > m_nextDue;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_timings.frames;
+    if (late)
+        ++m_timings.lateFrames;
+}
+
+void PipelineScheduler::record(PipelineStage s, double msec)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    StageTiming& t = stage(s);
+    t.lastMsec = msec;
+    t.avgMsec  = (t.runs > 0) ? t.avgMsec + kEmaAlpha * (msec - t.avgMsec) : msec;
+    ++t.runs;
+}
+
+void PipelineScheduler::skip(PipelineStage s)
+{
+    if (s == PipelineStage::Detect)
+        ++m_detectDeferred;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++stage(s).skipped;
+}
+
+void PipelineScheduler::detectSubmitted()
+{
+    m_detectDeferred = 0;
+}
+
+int PipelineScheduler::msecUntilNextFrame() const
+{
+    const double ms = msecBetween(Clock::now(), m_nextDue);
+    return ms > 0.0 ? static_cast<int>(std::floor(ms)) : 0;
+}
+
+PipelineTimings PipelineScheduler::timings() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_timings;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+// 帧流水线各阶段（帧线程内同步执行的部分；检测推理本身在 DetectionWorker 线程）
+enum class PipelineStage { Capture, Filter, Detect, Render, Sink };
+constexpr std::size_t kPipelineStageCount = 5;
+
+struct StageTiming {
+    double        lastMsec = 0.0;
+    double        avgMsec  = 0.0;   // EMA
+    std::uint64_t runs     = 0;
+    std::uint64_t skipped  = 0;     // 因截止时刻被跳过/降级的次数
+};
+
+struct PipelineTimings {
+    std::array<StageTiming, kPipelineStageCount> stages{};
+    double        periodMsec = 0.0;   // 帧间隔预算
+    std::uint64_t frames     = 0;
+    std::uint64_t lateFrames = 0;     // 完成时已超过下一帧截止时刻的帧
+};
+
+// 本帧执行计划：滤镜按预计耗时与剩余预算降级，检测提交按推理线程负载推迟
+struct FramePlan {
+    bool   runDetect      = true;    // false：推理线程仍忙，本帧不提交检测，跟踪器外推
+    bool   degradeFilters = false;   // true：跳过可降级滤镜（CLAHE 等）
+    double budgetMsec     = 0.0;     // 本帧开始时距下一帧截止时刻的剩余时间
+};
+
+// 截止时刻驱动的帧调度：文件源按帧时间戳对齐墙钟，实时源按帧间隔节拍；
+// 预计超时则降级滤镜，保证输出帧率平稳。检测提交在帧线程上几乎无开销，
+// 不随帧预算舍弃：仅在推理线程仍忙时推迟，且连续推迟不超过 kMaxDetectDeferrals 次
+class PipelineScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int kDegradeHoldFrames  = 30;   // 降级后至少保持的帧数
+    static constexpr int kMaxDetectDeferrals = 8;    // 连续推迟检测的上限，达到后强制提交
+
+    // 打开源/恢复播放时调用；fps ≤ 0 按 30 处理
+    void reset(double fps);
+    // 跳转后重新以下一帧对齐墙钟（保留各阶段耗时统计）
+    void reanchor();
+
+    // ptsMsec < 0 表示实时源（无时间戳）；detectBusy：推理线程仍在处理上一次提交
+    FramePlan beginFrame(double ptsMsec, bool detectBusy = false);
+    void      endFrame();
+
+    void record(PipelineStage stage, double msec);
+    // skip(Detect) 计入连续推迟次数，detectSubmitted() 清零
+    void skip(PipelineStage stage);
+    void detectSubmitted();
+
+    // 计时作用域：析构时记录耗时
+    class Scope {
+    public:
+        Scope(PipelineScheduler& s, PipelineStage stage)
+            : m_sched(s), m_stage(stage), m_start(Clock::now()) {}
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        PipelineScheduler& m_sched;
+        PipelineStage      m_stage;
+        Clock::time_point  m_start;
+    };
+
+    // 距下一帧截止时刻的毫秒数（已过期为 0），用于单次定时器
+    int msecUntilNextFrame() const;
+
+    PipelineTimings timings() const;   // 任意线程可调用
+
+private:
+    static double msecBetween(Clock::time_point a, Clock::time_point b);
+    StageTiming&  stage(PipelineStage s) { return m_timings.stages[static_cast<std::size_t>(s)]; }
+
+    // 以下仅帧线程访问
+    double            m_periodMsec = 1000.0 / 30.0;
+    bool              m_anchored   = false;
+    Clock::time_point m_anchorWall;
+    double            m_anchorPts  = 0.0;
+    Clock::time_point m_deadline;         // 本帧截止时刻
+    Clock::time_point m_nextDue;          // 下一帧截止时刻
+    double            m_lastPts    = -1.0;
+    int               m_degradeHold = 0;  // 降级后至少保持的帧数，避免逐帧振荡
+    int               m_detectDeferred = 0; // 连续推迟检测提交的次数
+
+    mutable std::mutex m_mutex;           // 保护 m_timings
+    PipelineTimings    m_timings;
+};
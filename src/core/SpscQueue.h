@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// 有界单生产者/单消费者无锁环形队列
+// 槽位在构造时一次性分配，元素按值移动进出；阻塞版本采用自旋 → yield → 短睡眠退避
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : m_slots(capacity + 1)   // 留一个空槽区分满/空
+    {}
+
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 仅生产者线程调用
+    bool tryPush(T& item)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t next = increment(tail);
+        if (next == m_head.load(std::memory_order_acquire))
+            return false;   // 满
+        m_slots[tail] = std::move(item);
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // 仅消费者线程调用
+    bool tryPop(T& item)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;   // 空
+        item = std::move(m_slots[head]);
+        m_slots[head] = T{};   // 及时释放引用（如 cv::Mat 缓冲区）
+        m_head.store(increment(head), std::memory_order_release);
+        return true;
+    }
+
+    // 阻塞直到入队成功；stop 置位时放弃并返回 false
+    bool push(T& item, const std::atomic<bool>& stop)
+    {
+        for (int spin = 0; !tryPush(item); ++spin) {
+            if (stop.load(std::memory_order_relaxed))
+                return false;
+            backoff(spin);
+        }
+        return true;
+    }
+
+    // 阻塞直到出队成功；stop 置位时放弃并返回 false
+    bool pop(T& item, const std::atomic<bool>& stop)
+    {
+        for (int spin = 0; !tryPop(item); ++spin) {
+            if (stop.load(std::memory_order_relaxed))
+                return false;
+            backoff(spin);
+        }
+        return true;
+    }
+
+    // 近似元素个数（仅供统计）
+    std::size_t sizeApprox() const
+    {
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : tail + m_slots.size() - head;
+    }
+
+    std::size_t capacity() const { return m_slots.size() - 1; }
+
+private:
+    std::size_t increment(std::size_t i) const
+    {
+        return (i + 1 == m_slots.size()) ? 0 : i + 1;
+    }
+
+    static void backoff(int spin)
+    {
+        if (spin < 64)
+            return;
+        if (spin < 128)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    std::vector<T>           m_slots;
+    alignas(64) std::atomic<std::size_t> m_head{0};   // 消费者写
+    alignas(64) std::atomic<std::size_t> m_tail{0};   // 生产者写
+};
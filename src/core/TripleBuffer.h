@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// 单生产者/单消费者三缓冲邮箱：生产者总能立即写入，消费者只取到最新一份，
+// 中间未被取走的版本直接被覆盖（不排队）。三个槽位在构造时分配，元素跨轮复用
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&)            = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // ──── 生产者线程 ────
+    // 写入槽，publish 之前消费者不可见
+    T& back() { return m_slots[m_back]; }
+
+    // 发布 back()，与中间槽交换；返回 true 表示覆盖了一份未被取走的版本
+    bool publish()
+    {
+        const std::uint8_t prev = m_middle.exchange(static_cast<std::uint8_t>(m_back | kFresh),
+                                                    std::memory_order_acq_rel);
+        m_back = prev & kIndexMask;
+        return (prev & kFresh) != 0;
+    }
+
+    // ──── 消费者线程 ────
+    // 有新版本时与中间槽交换并返回 true，此后 front() 为最新版本
+    bool fetch()
+    {
+        if ((m_middle.load(std::memory_order_acquire) & kFresh) == 0)
+            return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    // 最近一次 fetch 取得的版本（下一次 fetch 之前保持不变）
+    const T& front() const { return m_slots[m_front]; }
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x03;
+    static constexpr std::uint8_t kFresh     = 0x04;
+
+    std::array<T, 3>          m_slots{};
+    std::uint8_t              m_back  = 0;   // 仅生产者访问
+    std::uint8_t              m_front = 1;   // 仅消费者访问
+    std::atomic<std::uint8_t> m_middle{2};
+};
@@ -0,0 +1,727 @@
+#include "VideoController.h"
+#include "VideoSource/CameraSource.h"
+#include "VideoSource/FileSource.h"
+#include "VideoSource/ScreenSource.h"
+#include "Filter/GrayscaleFilter.h"
+#include "Filter/GaussianFilter.h"
+#include "Filter/CannyFilter.h"
+#include "Filter/ThresholdFilter.h"
+#include "Filter/HistEqFilter.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QMetaObject>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+namespace {
+
+constexpr double      kMinProcScale = 0.1;
+constexpr std::size_t kMaxGateDirty = 256;   // 累计的源变化区域超过该数时改按帧差评估
+
+// 检测框坐标按比例缩放（源分辨率 → 代理分辨率）
+DetectionList scaleDetections(const DetectionList& dets, double scale)
+{
+    if (scale == 1.0)
+        return dets;
+
+    DetectionList out = dets;
+    const float s = static_cast<float>(scale);
+    for (Detection& d : out)
+        d.bbox = cv::Rect2f(d.bbox.x * s, d.bbox.y * s, d.bbox.width * s, d.bbox.height * s);
+    return out;
+}
+
+template <typename F>
+std::shared_ptr<F> findAs(FilterChain& chain, const std::string& id)
+{
+    return std::dynamic_pointer_cast<F>(chain.find(id));
+}
+
+} // namespace
+
+VideoController::VideoController(QObject* parent)
+    : QObject(parent)
+    , m_renderer(m_detector.labels())
+{
+    qRegisterMetaType<cv::Mat>("cv::Mat");
+    qRegisterMetaType<DetectionList>("DetectionList");
+    qRegisterMetaType<PipelineTimings>("PipelineTimings");
+
+    // 默认滤镜链：全部禁用，由 UI 勾选启用
+    const auto add = [this](std::shared_ptr<FilterBase> f) {
+        f->setEnabled(false);
+        m_filterChain.append(std::move(f));
+    };
+    add(std::make_shared<GrayscaleFilter>());
+    add(std::make_shared<HistEqFilter>());
+    add(std::make_shared<GaussianFilter>());
+    add(std::make_shared<ThresholdFilter>());
+    add(std::make_shared<CannyFilter>());
+
+    m_outputDir = QDir::current().filePath("output");
+
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setTimerType(Qt::PreciseTimer);
+    m_frameTimer->setSingleShot(true);
+    connect(m_frameTimer, &QTimer::timeout, this, &VideoController::doFrameLoop);
+
+    m_detWorker.start();
+    m_modelLoader = std::thread([this] { modelLoaderLoop(); });
+}
+
+VideoController::~VideoController()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_loadMutex);
+        m_loaderStop = true;
+    }
+    m_loadCv.notify_one();
+    m_modelLoader.join();   // 进行中的加载会完成，其回调因对象销毁不再执行
+    if (m_workerThread && m_workerThread->isRunning()) {
+        // 定时器与输入源归工作线程所有，需在该线程内关闭
+        QMetaObject::invokeMethod(this, [this] { closeSource(); }, Qt::BlockingQueuedConnection);
+        m_workerThread->quit();
+        m_workerThread->wait();
+    } else {
+        closeSource();
+    }
+}
+
+void VideoController::moveToWorkerThread()
+{
+    if (m_workerThread)
+        return;
+    m_workerThread = new QThread;
+    m_workerThread->setObjectName("VideoController");
+    connect(m_workerThread, &QThread::finished, m_workerThread, &QObject::deleteLater);
+    moveToThread(m_workerThread);   // m_frameTimer 作为子对象一并迁移
+    m_workerThread->start();
+}
+
+bool VideoController::takeDisplayFrame(DisplayFrame& out)
+{
+    // 先清标志再取帧：取帧之后发布的新帧会再次发出通知
+    m_displayPending = false;
+    if (!m_display.fetch())
+        return false;
+    out = m_display.front();
+    return true;
+}
+
+// ──── 输入源 ────────────────────────────────────────────────
+
+void VideoController::onOpenCamera(int deviceIndex)
+{
+    openSource(std::make_unique<CameraSource>(deviceIndex));
+}
+
+void VideoController::onOpenFile(const QString& path)
+{
+    openSource(std::make_unique<FileSource>(path.toStdString()));
+}
+
+void VideoController::onOpenScreen(QRect region, double fps)
+{
+    const cv::Rect r(region.x(), region.y(), region.width(), region.height());
+    openSource(std::make_unique<ScreenSource>(r, fps));
+}
+
+void VideoController::openSource(std::unique_ptr<VideoSource> source)
+{
+    closeSource();
+
+    // 设备读取移至独立采集线程，帧循环只从帧槽环中取帧
+    auto threaded = std::make_unique<ThreadedSource>(std::move(source));
+    if (!threaded->open()) {
+        emit sourceError(QString::fromStdString("无法打开输入源：" + threaded->description()));
+        return;
+    }
+
+    m_source = std::move(threaded);
+    m_paused = false;
+    m_openTime = std::chrono::steady_clock::now();
+    m_detWorker.reset();
+    m_lastResult = DetectionResult{};
+    m_tracker.reset();
+    m_tracked.clear();
+    m_motionGate.reset();
+    m_gateDirty.clear();
+    m_gateDirtyFull = true;
+    m_sceneStatic   = false;
+
+    emit sourceOpened(QString::fromStdString(m_source->description()));
+    emit resolutionChanged(m_source->width(), m_source->height());
+    if (m_source->durationMsec() > 0.0)
+        emit durationMsec(m_source->durationMsec());
+
+    m_scheduler.reset(m_source->fps());
+    startFrameTimer();
+}
+
+void VideoController::closeSource()
+{
+    stopFrameTimer();
+
+    if (m_recording) {
+        const auto path = m_recorder.stop();
+        m_recording = false;
+        emit recordingStateChanged(false);
+        if (!path.empty())
+            emit recordingSaved(QString::fromStdString(path.string()));
+    }
+
+    if (m_source) {
+        m_source->close();
+        m_source.reset();
+        emit sourceClosed();
+    }
+}
+
+void VideoController::onPlayPause()
+{
+    if (!m_source)
+        return;
+    m_paused = !m_paused;
+    if (m_paused) {
+        m_source->pause();
+        stopFrameTimer();
+    } else {
+        m_source->resume();
+        startFrameTimer();
+    }
+}
+
+void VideoController::onStop()
+{
+    closeSource();
+}
+
+void VideoController::onSeek(double posMsec)
+{
+    if (m_source && m_source->seek(posMsec)) {
+        m_scheduler.reanchor();
+        emit positionMsec(m_source->posMsec());
+    }
+}
+
+void VideoController::startFrameTimer()
+{
+    // 立即处理首帧，此后由 doFrameLoop 按调度器给出的截止时刻重新触发
+    m_scheduler.reanchor();
+    m_frameTimer->start(0);
+}
+
+void VideoController::stopFrameTimer()
+{
+    if (m_frameTimer)
+        m_frameTimer->stop();
+}
+
+// ──── 帧循环 ────────────────────────────────────────────────
+
+void VideoController::doFrameLoop()
+{
+    if (!m_source || m_paused)
+        return;
+
+    // 采集线程暂未产出新帧时立即重试（read 内已限时等待），仅在源结束时关闭
+    cv::Mat frame;
+    {
+        PipelineScheduler::Scope timing(m_scheduler, PipelineStage::Capture);
+        if (!m_source->read(frame))
+            frame.release();
+    }
+    if (frame.empty()) {
+        if (m_source->finished())
+            closeSource();
+        else
+            m_frameTimer->start(0);
+        return;
+    }
+
+    // 运动门控：累计源报告的变化区域直到下次评估；任一帧未知（空）即按帧差评估
+    if (m_motionGating) {
+        const std::vector<cv::Rect> dirty = m_source->dirtyRegions();
+        if (dirty.empty() || m_gateDirty.size() + dirty.size() > kMaxGateDirty) {
+            m_gateDirty.clear();
+            m_gateDirtyFull = true;
+        } else if (!m_gateDirtyFull) {
+            m_gateDirty.insert(m_gateDirty.end(), dirty.begin(), dirty.end());
+        }
+    }
+
+    // 文件源按帧时间戳对齐墙钟，实时源按帧间隔节拍；预计超出本帧预算时降级滤镜，
+    // 推理线程仍忙时推迟检测提交
+    const double    ts   = frameTimestampMsec();
+    const FramePlan plan = m_scheduler.beginFrame(m_source->durationMsec() > 0.0 ? ts : -1.0,
+                                                  m_detWorker.busy());
+
+    // 1. 代理分辨率：先以 INTER_AREA 缩小，滤镜链与显示均在代理帧上运行
+    const double scale = std::clamp(m_procScale.load(), kMinProcScale, 1.0);
+    cv::Mat input = frame;
+    cv::Mat processed;
+    {
+        PipelineScheduler::Scope timing(m_scheduler, PipelineStage::Filter);
+        if (scale < 1.0) {
+            // 代理帧取自缓冲池，仍被 GUI 持有的缓冲区不会被复写
+            const cv::Size proxySize(cvRound(frame.cols * scale), cvRound(frame.rows * scale));
+            input = m_proxyPool.acquire(proxySize, frame.type());
+            cv::resize(frame, input, proxySize, 0.0, 0.0, cv::INTER_AREA);
+        }
+
+        m_filterChain.setDegraded(plan.degradeFilters);
+        m_filterChain.setProcessingScale(scale);
+        processed = m_filterChain.process(input);
+    }
+    if (plan.degradeFilters)
+        m_scheduler.skip(PipelineStage::Filter);
+
+    // 2. 检测：异步线程在源分辨率上推理最新提交的帧（小目标不因代理缩放丢失），
+    //    显示沿用最近一次结果，帧循环不等待推理
+    const std::uint64_t frameId = ++m_frameId;
+    bool freshResult = false;
+    {
+        PipelineScheduler::Scope timing(m_scheduler, PipelineStage::Detect);
+        if (m_detectionEnabled && m_tiled.isLoaded()) {
+            const int interval = std::max(m_skipFrames + 1,
+                                          m_detWorker.recommendedInterval(m_source->fps()));
+            if (frameId - m_lastSubmitId >= static_cast<std::uint64_t>(interval)) {
+                if (!plan.runDetect) {
+                    // 推理线程仍忙：推迟到其空闲后提交最新帧，期间由跟踪器外推
+                    m_scheduler.skip(PipelineStage::Detect);
+                } else {
+                    m_lastSubmitId = frameId;
+                    m_scheduler.detectSubmitted();
+                    // 运动门控：静止则本轮不提交，局部运动只提交运动区域
+                    MotionDecision gate;
+                    if (m_motionGating) {
+                        gate = m_gateDirtyFull ? m_motionGate.evaluate(frame)
+                                               : m_motionGate.evaluateRegions(m_gateDirty, frame.size());
+                        m_gateDirty.clear();
+                        m_gateDirtyFull = false;
+                        m_sceneStatic   = gate.mode == MotionDecision::Mode::Skip;
+                    }
+                    if (gate.mode != MotionDecision::Mode::Skip)
+                        m_detWorker.submit(frameId, ts, frame, std::move(gate.regions));
+                }
+            }
+        }
+        freshResult = m_detWorker.latest(m_lastResult, m_lastResult.frameId);
+
+        // 跟踪：新结果到达时关联修正，其余帧按恒速模型外推，框不再停留在推理帧位置；
+        // 门控判定画面静止时原地保持，停下的目标不被外推走也不因久未匹配而隐藏
+        if (!m_trackingEnabled)
+            m_tracked = m_lastResult.detections;
+        else if (freshResult)
+            m_tracked = m_tracker.update(m_lastResult.detections, m_lastResult.frameId, frameId,
+                                         m_lastResult.regions);
+        else if (m_detectionEnabled)
+            m_tracked = (m_motionGating && m_sceneStatic) ? m_tracker.hold(frameId)
+                                                          : m_tracker.predict(frameId);
+    }
+    const DetectionList& detections = m_tracked;
+
+    // 3. 输出：录制与导出取 sink 分辨率，显示取代理分辨率
+    {
+        PipelineScheduler::Scope timing(m_scheduler, PipelineStage::Sink);
+        const bool fullResSinks = m_fullResSinks;
+        const double sinkScale  = fullResSinks ? 1.0 : scale;
+        if (m_recording)
+            m_recorder.writeFrame(sinkFrame(frame, processed));
+        // 跟踪开启时每帧导出外推后的位置；关闭时每个检测结果只导出一次，时间戳取其来源帧
+        if (m_exporter && m_exporter->isOpen() && !detections.empty()) {
+            if (m_trackingEnabled)
+                m_exporter->appendFrame(static_cast<std::int64_t>(ts),
+                                        scaleDetections(detections, sinkScale));
+            else if (freshResult)
+                m_exporter->appendFrame(static_cast<std::int64_t>(m_lastResult.timestampMsec),
+                                        scaleDetections(detections, sinkScale));
+        }
+    }
+
+    m_lastOrigFrame      = frame;
+    m_lastProcessedFrame = processed;
+
+    {
+        PipelineScheduler::Scope timing(m_scheduler, PipelineStage::Render);
+        // 写入三缓冲邮箱而非按值排队：GUI 变慢时旧帧被覆盖，不在事件队列中堆积
+        DisplayFrame& out = m_display.back();
+        out.original   = input;
+        out.processed  = processed;
+        out.detections = scaleDetections(detections, scale);
+        out.frameId    = frameId;
+        m_display.publish();
+        if (!m_displayPending.exchange(true))
+            emit displayFrameAvailable();
+
+        m_fpsCounter.tick();
+        emit fpsUpdated(m_fpsCounter.current());
+        if (m_source->durationMsec() > 0.0)
+            emit positionMsec(m_source->posMsec());
+    }
+
+    m_scheduler.endFrame();
+    emit pipelineTimingsUpdated(m_scheduler.timings());
+
+    // 单次定时器在下一帧截止时刻再次触发，处理耗时与定时抖动不累积
+    m_frameTimer->start(m_scheduler.msecUntilNextFrame());
+}
+
+double VideoController::frameTimestampMsec() const
+{
+    if (m_source && m_source->durationMsec() > 0.0)
+        return m_source->posMsec();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - m_openTime).count();
+}
+
+cv::Mat VideoController::sinkFrame(const cv::Mat& original, const cv::Mat& processed)
+{
+    if (processed.size() == original.size() || !m_fullResSinks)
+        return processed;
+
+    // 在源分辨率上重跑滤镜链（空间参数按 1.0 执行）
+    // 链的缓冲池与时域 CLAHE 按分辨率分别保留缓冲区/状态，两路交替不会互相逐出
+    return m_filterChain.process(original, 1.0);
+}
+
+// ──── 滤镜 ──────────────────────────────────────────────────
+
+void VideoController::onSetFilterEnabled(const QString& filterId, bool enabled)
+{
+    if (auto f = m_filterChain.find(filterId.toStdString()))
+        f->setEnabled(enabled);
+}
+
+void VideoController::onSetGaussianParams(int kernelSteps, double sigma)
+{
+    auto f = findAs<GaussianFilter>(m_filterChain, "gaussian");
+    if (!f)
+        return;
+    GaussianParams p = f->params();
+    p.kernelSize = 2 * std::max(0, kernelSteps) + 1;
+    p.sigmaX     = sigma;
+    f->setParams(p);
+}
+
+void VideoController::onSetCannyParams(double thresh1, double thresh2)
+{
+    auto f = findAs<CannyFilter>(m_filterChain, "canny");
+    if (!f)
+        return;
+    CannyParams p = f->params();
+    p.threshold1 = thresh1;
+    p.threshold2 = thresh2;
+    f->setParams(p);
+}
+
+void VideoController::onSetThresholdParams(int type, int value)
+{
+    auto f = findAs<ThresholdFilter>(m_filterChain, "threshold");
+    if (!f)
+        return;
+    ThresholdParams p = f->params();
+    p.type  = static_cast<ThresholdType>(std::clamp(type, 0, static_cast<int>(ThresholdType::Sauvola)));
+    p.value = value;
+    f->setParams(p);
+}
+
+void VideoController::onSetHistEqParams(bool useClahe, double clipLimit)
+{
+    auto f = findAs<HistEqFilter>(m_filterChain, "histeq");
+    if (!f)
+        return;
+    HistEqParams p = f->params();
+    p.useCLAHE  = useClahe;
+    p.clipLimit = clipLimit;
+    f->setParams(p);
+}
+
+void VideoController::onSetProcessingScale(double scale, bool fullResSinks)
+{
+    m_procScale    = std::clamp(scale, kMinProcScale, 1.0);
+    m_fullResSinks = fullResSinks;
+}
+
+// ──── 检测 ──────────────────────────────────────────────────
+
+void VideoController::onSetDetectorEngine(int engine)
+{
+    const auto e = static_cast<DetectorEngine>(engine);
+    if (e != DetectorEngine::OpenCvDnn && e != DetectorEngine::OnnxRuntime)
+        return;
+    m_engine = e;
+}
+
+void VideoController::onLoadModel(const QString& modelPath, const QString& labelsPath)
+{
+    // 读取与预热在加载线程完成，期间帧循环继续使用旧模型；此处只登记请求，不等待上一次加载
+    LoadRequest req;
+    req.gen        = ++m_loadGen;
+    req.modelPath  = modelPath;
+    req.labelsPath = labelsPath;
+    req.engine     = m_engine;
+
+    if (m_engine == DetectorEngine::OnnxRuntime) {
+        if (!DetectorEngines::available(DetectorEngine::OnnxRuntime)) {
+            emit modelLoaded(false, QStringLiteral("当前构建未包含 ONNX Runtime 引擎（RVSFDT_WITH_ONNXRUNTIME）"));
+            return;
+        }
+        if (!m_ortDetector) {
+            m_ortDetector = DetectorEngines::create(DetectorEngine::OnnxRuntime);
+            m_ortDetector->setConfThreshold(m_detector.confThreshold());
+            m_ortDetector->setNmsThreshold(m_detector.nmsThreshold());
+        }
+        req.ort = m_ortDetector.get();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_loadMutex);
+        m_loadRequest = std::move(req);
+    }
+    m_loadCv.notify_one();
+}
+
+void VideoController::modelLoaderLoop()
+{
+    for (;;) {
+        LoadRequest req;
+        {
+            std::unique_lock<std::mutex> lock(m_loadMutex);
+            m_loadCv.wait(lock, [this] { return m_loaderStop || m_loadRequest.has_value(); });
+            if (m_loaderStop)
+                return;
+            req = std::move(*m_loadRequest);
+            m_loadRequest.reset();
+        }
+
+        if (req.engine == DetectorEngine::OnnxRuntime)
+            loadOrtModel(req);
+        else
+            loadDnnModel(req);
+    }
+}
+
+void VideoController::loadDnnModel(const LoadRequest& req)
+{
+    auto model = std::make_shared<PreparedModel>();
+    const bool ok = m_detector.prepareModel(req.modelPath.toStdString(),
+                                            req.labelsPath.toStdString(), *model);
+    if (req.gen != m_loadGen) {
+        if (ok)
+            m_detector.recycle(std::move(*model));
+        return;
+    }
+
+    const std::uint64_t gen = req.gen;
+    const QString modelPath = req.modelPath;
+    QMetaObject::invokeMethod(this, [this, ok, gen, model, modelPath] {
+        if (gen != m_loadGen) {
+            if (ok)
+                m_detector.recycle(std::move(*model));
+            return;
+        }
+        if (!ok) {
+            emit modelLoaded(false, QStringLiteral("模型加载失败：") + modelPath);
+            return;
+        }
+        installDnnModel(gen, model, modelPath);
+    }, Qt::QueuedConnection);
+}
+
+void VideoController::installDnnModel(std::uint64_t gen, std::shared_ptr<PreparedModel> model,
+                                      const QString& modelPath)
+{
+    constexpr int kInstallRetryMsec = 2;
+
+    if (gen != m_loadGen) {
+        m_detector.recycle(std::move(*model));
+        return;
+    }
+    const ModelLoadStats stats = model->stats;
+    if (!m_detector.tryInstall(*model)) {
+        QTimer::singleShot(kInstallRetryMsec, this, [this, gen, model, modelPath] {
+            installDnnModel(gen, model, modelPath);
+        });
+        return;
+    }
+
+    m_tiled.setInner(m_detector);
+    const QString detail = stats.fromCache
+        ? QStringLiteral("缓存命中，%1 ms").arg(stats.loadMsec, 0, 'f', 1)
+        : QStringLiteral("读取 %1 ms，预热 %2 ms")
+              .arg(stats.loadMsec, 0, 'f', 1).arg(stats.warmupMsec, 0, 'f', 1);
+    onModelActivated(QStringLiteral("模型加载成功（%1）").arg(detail));
+}
+
+void VideoController::loadOrtModel(const LoadRequest& req)
+{
+    // ORT 会话在 loadModel 内一次建成；若 ORT 正在使用，加载期间其推理在检测线程上等待。
+    // 被取代的请求同样会改写 ORT 检测器，随后由最新请求再次覆盖
+    DetectorBase* ort = req.ort;
+    const auto t0 = std::chrono::steady_clock::now();
+    const bool ok = ort->loadModel(req.modelPath.toStdString(), req.labelsPath.toStdString());
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    const std::uint64_t gen = req.gen;
+    const QString modelPath = req.modelPath;
+    QMetaObject::invokeMethod(this, [this, ok, gen, ort, ms, modelPath] {
+        if (gen != m_loadGen)
+            return;
+        if (!ok) {
+            emit modelLoaded(false, QStringLiteral("模型加载失败：") + modelPath);
+            return;
+        }
+        m_tiled.setInner(*ort);
+        onModelActivated(QStringLiteral("模型加载成功（ONNX Runtime，%1 ms）").arg(ms, 0, 'f', 1));
+    }, Qt::QueuedConnection);
+}
+
+void VideoController::onModelActivated(const QString& message)
+{
+    // 类别表可能已变化，旧轨迹不再可信
+    m_tracker.reset();
+    m_tracked.clear();
+    emit modelLoaded(true, message);
+}
+
+void VideoController::onSetDetectionEnabled(bool enabled)
+{
+    m_detectionEnabled = enabled;
+    if (!enabled) {
+        m_detWorker.reset();
+        m_lastResult = DetectionResult{};
+        m_tracker.reset();
+        m_tracked.clear();
+    }
+}
+
+void VideoController::onSetConfThreshold(float thresh)
+{
+    m_detector.setConfThreshold(thresh);
+    if (m_ortDetector)
+        m_ortDetector->setConfThreshold(thresh);
+}
+
+void VideoController::onSetNmsThreshold(float thresh)
+{
+    m_detector.setNmsThreshold(thresh);
+    if (m_ortDetector)
+        m_ortDetector->setNmsThreshold(thresh);
+}
+
+void VideoController::onSetSkipFrames(int n)
+{
+    m_skipFrames = std::max(0, n);
+}
+
+void VideoController::onSetMotionGating(bool enabled)
+{
+    if (enabled && !m_motionGating) {
+        m_motionGate.reset();
+        m_gateDirty.clear();
+        m_gateDirtyFull = true;
+        m_sceneStatic   = false;
+    }
+    m_motionGating = enabled;
+}
+
+void VideoController::onSetTiledInference(bool enabled, bool fullFramePass)
+{
+    TileConfig cfg = m_tiled.config();
+    cfg.enabled   = enabled;
+    cfg.fullFrame = fullFramePass;
+    m_tiled.setConfig(cfg);
+}
+
+void VideoController::onSetTrackingEnabled(bool enabled)
+{
+    if (enabled && !m_trackingEnabled)
+        m_tracker.reset();
+    m_trackingEnabled = enabled;
+}
+
+// ──── 导出 ──────────────────────────────────────────────────
+
+void VideoController::onScreenshot()
+{
+    if (m_lastOrigFrame.empty())
+        return;
+
+    cv::Mat shot = sinkFrame(m_lastOrigFrame, m_lastProcessedFrame).clone();
+    const double sinkScale = static_cast<double>(shot.cols) / m_lastOrigFrame.cols;
+    m_renderer.render(shot, scaleDetections(m_tracked, sinkScale));
+
+    const auto path = ResultExporter::saveScreenshot(shot, m_outputDir.toStdString());
+    if (!path.empty())
+        emit screenshotSaved(QString::fromStdString(path.string()));
+}
+
+void VideoController::onExportDetections(const QString& format)
+{
+    // 再次调用即结束当前导出
+    if (m_exporter) {
+        m_exporter->close();
+        m_exporter.reset();
+        return;
+    }
+
+    const bool json = format.compare("json", Qt::CaseInsensitive) == 0;
+    const QString name = QString("detections_%1.%2")
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"), json ? "json" : "csv");
+    m_exporter = std::make_unique<ResultExporter>(
+        QDir(m_outputDir).filePath(name).toStdString(),
+        json ? ResultExporter::Format::JSON : ResultExporter::Format::CSV);
+    if (!m_exporter->open()) {
+        m_exporter.reset();
+        emit sourceError(QStringLiteral("无法创建导出文件：") + name);
+    }
+}
+
+void VideoController::onRecordToggle()
+{
+    if (m_recording) {
+        const auto path = m_recorder.stop();
+        m_recording = false;
+        emit recordingStateChanged(false);
+        if (!path.empty())
+            emit recordingSaved(QString::fromStdString(path.string()));
+        return;
+    }
+
+    if (!m_source)
+        return;
+
+    RecordConfig cfg;
+    cfg.outputDir = m_outputDir.toStdString();
+    cfg.fps       = m_source->fps() > 0.0 ? m_source->fps() : 30.0;
+    m_recorder.setConfig(cfg);
+    m_recording = m_recorder.start();
+    emit recordingStateChanged(m_recording);
+}
+
+void VideoController::onSetRecordOutputDir(const QString& dir)
+{
+    m_outputDir = dir;
+}
+
+// ──── FPS 统计 ──────────────────────────────────────────────
+
+void VideoController::FpsCounter::tick()
+{
+    const auto now = std::chrono::steady_clock::now();
+    m_times.push_back(now);
+    // 仅保留最近 1 秒内的时间戳
+    while (!m_times.empty() && now - m_times.front() > std::chrono::seconds(1))
+        m_times.pop_front();
+}
+
+double VideoController::FpsCounter::current() const
+{
+    if (m_times.size() < 2)
+        return 0.0;
+    const double span = std::chrono::duration<double>(m_times.back() - m_times.front()).count();
+    return span > 0.0 ? (m_times.size() - 1) / span : 0.0;
+}
@@ -6,14 +6,41 @@
 #include <QRect>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #include "VideoSource/VideoSource.h"   // VideoSource 纯虚基类
+#include "VideoSource/ThreadedSource.h"
 #include "Filter/FilterChain.h"
+#include "PipelineScheduler.h"
+#include "TripleBuffer.h"
 #include "Detection/YOLODetector.h"
+#include "Detection/DetectorEngine.h"
 #include "Detection/DetectionRenderer.h"
+#include "Detection/DetectionWorker.h"
+#include "Detection/TiledDetector.h"
+#include "Detection/SortTracker.h"
+#include "Detection/MotionGate.h"
 #include "Export/VideoRecorder.h"
 #include "Export/ResultExporter.h"
 
+// 跨线程 QueuedConnection 传递的自定义类型
+Q_DECLARE_METATYPE(cv::Mat)
+Q_DECLARE_METATYPE(DetectionList)
+Q_DECLARE_METATYPE(PipelineTimings)
+
+// 交给 GUI 的显示帧：像素为池化缓冲区的引用（不拷贝），槽位被覆盖时引用释放、缓冲区回到池中
+struct DisplayFrame {
+    cv::Mat       original;     // 代理分辨率源帧
+    cv::Mat       processed;    // 滤镜链输出（BGR）
+    DetectionList detections;   // 代理分辨率坐标
+    std::uint64_t frameId = 0;
+};
+
 class VideoController : public QObject {
     Q_OBJECT
 
@@ -24,11 +51,15 @@ public:
     // 在 QThread 中启动（由 MainWindow 调用）
     void moveToWorkerThread();
 
+    // 取最新显示帧（仅 GUI 线程调用）；自上次调用以来没有新帧时返回 false
+    bool takeDisplayFrame(DisplayFrame& out);
+
 signals:
     // ──── 向 GUI 回传数据 ────
-    // 每帧处理完成后发射（跨线程 QueuedConnection）
-    void frameReady(cv::Mat original, cv::Mat processed, DetectionList detections);
+    // 显示邮箱中有新帧；GUI 调用 takeDisplayFrame 之前不会重复发射，事件队列中至多一个通知
+    void displayFrameAvailable();
     void fpsUpdated(double fps);
+    void pipelineTimingsUpdated(PipelineTimings timings);   // 各阶段耗时与跳过/超时计数
     void resolutionChanged(int width, int height);
     void durationMsec(double ms);       // 仅 FileSource 有效
     void positionMsec(double ms);       // 当前播放位置
@@ -55,15 +86,21 @@ public slots:
     void onSetCannyParams(double thresh1, double thresh2);
     void onSetThresholdParams(int type, int value);
     void onSetHistEqParams(bool useClahe, double clipLimit);
-    void onSetSharpenParams(double strength, double sigma);
-    void onSetBgSubParams(int algo);
+
+    // 代理分辨率：滤镜链与显示在缩小 scale 倍的帧上运行（(0, 1]，1 = 源分辨率）
+    // fullResSinks 为 true 时录制/截图仍取全分辨率处理结果，否则直接使用代理结果
+    void onSetProcessingScale(double scale, bool fullResSinks);
 
     // 检测
     void onLoadModel(const QString& modelPath, const QString& labelsPath);
+    void onSetDetectorEngine(int engine);      // DetectorEngine，下次 onLoadModel 时生效
     void onSetDetectionEnabled(bool enabled);
     void onSetConfThreshold(float thresh);
     void onSetNmsThreshold(float thresh);
     void onSetSkipFrames(int n);
+    void onSetTrackingEnabled(bool enabled);   // 两次推理之间用跟踪器外推检测框
+    void onSetMotionGating(bool enabled);      // 静止时跳过检测、局部运动时仅检测运动区域
+    void onSetTiledInference(bool enabled, bool fullFramePass);   // 高分辨率源的小目标切片推理
 
     // 导出
     void onScreenshot();                                 // 触发截图
@@ -72,40 +109,99 @@ public slots:
     void onSetRecordOutputDir(const QString& dir);
 
 private slots:
-    void doFrameLoop();   // 由 m_frameTimer 触发
+    void doFrameLoop();   // 由 m_frameTimer 单次触发，结束时按下一帧截止时刻重新定时
 
 private:
     void openSource(std::unique_ptr<VideoSource> source);
     void closeSource();
-    void startFrameTimer(double fps);
+    void startFrameTimer();
     void stopFrameTimer();
 
+    // ──── 模型加载（常驻加载线程，只处理最新一次请求） ────
+    struct LoadRequest {
+        std::uint64_t  gen = 0;
+        QString        modelPath;
+        QString        labelsPath;
+        DetectorEngine engine = DetectorEngine::OpenCvDnn;
+        DetectorBase*  ort    = nullptr;   // engine 为 OnnxRuntime 时的目标检测器
+    };
+    void modelLoaderLoop();
+    void loadDnnModel(const LoadRequest& req);
+    void loadOrtModel(const LoadRequest& req);
+    // 帧线程：替换 DNN 网络；检测线程正在推理时以定时器稍后重试，不阻塞帧循环
+    void installDnnModel(std::uint64_t gen, std::shared_ptr<PreparedModel> model,
+                         const QString& modelPath);
+    void onModelActivated(const QString& message);
+
+    // 录制/截图所需的处理帧：按配置复用代理结果或在全分辨率上重跑滤镜链
+    cv::Mat sinkFrame(const cv::Mat& original, const cv::Mat& processed);
+
+    // 当前帧时间戳：文件源取播放位置，实时源取自打开以来的时长
+    double frameTimestampMsec() const;
+
     // ──── 核心对象 ────
-    std::unique_ptr<VideoSource> m_source;
+    std::unique_ptr<ThreadedSource> m_source;   // 各输入源均经采集线程包装
     FilterChain                  m_filterChain;
     YOLODetector                 m_detector;
+    std::unique_ptr<DetectorBase> m_ortDetector;   // 首次选用时创建，之后常驻（m_tiled 可能指向它）
+    DetectorEngine               m_engine = DetectorEngine::OpenCvDnn;   // 帧线程访问
+    TiledDetector                m_tiled{m_detector};       // 未启用切片时直接转发
+    DetectionWorker              m_detWorker{m_tiled};      // 须在 m_tiled 之后构造
     DetectionRenderer            m_renderer;
     VideoRecorder                m_recorder;
-    ResultExporter               m_exporter;
+    std::unique_ptr<ResultExporter> m_exporter;   // 导出时按格式创建
+
+    // 后台读取/预热模型，完成后回到帧线程替换。新请求覆盖尚未开始的旧请求；
+    // 已开始的旧加载完成后按代号判定为过期并丢弃
+    std::thread                  m_modelLoader;
+    std::mutex                   m_loadMutex;
+    std::condition_variable      m_loadCv;
+    std::optional<LoadRequest>   m_loadRequest;      // m_loadMutex 保护
+    bool                         m_loaderStop = false;   // m_loadMutex 保护
+    std::atomic<std::uint64_t>   m_loadGen{0};       // 最近一次请求的代号
 
     // ──── 帧循环 ────
-    QTimer*          m_frameTimer   = nullptr;
+    QTimer*          m_frameTimer   = nullptr;   // 单次定时器，仅作为截止时刻唤醒
+    PipelineScheduler m_scheduler;
     QThread*         m_workerThread = nullptr;
 
-    // ──── 检测跳帧 ────
-    int              m_skipFrames   = 3;
-    int              m_frameCounter = 0;
+    // ──── 检测调度 ────
+    // 提交间隔 = max(m_skipFrames + 1, 按推理耗时与源帧率估算的间隔)
+    int              m_skipFrames   = 0;    // 用户设定的最少跳帧数
+    std::uint64_t    m_frameId      = 0;    // 源帧编号（跨输入源单调递增）
+    std::uint64_t    m_lastSubmitId = 0;
     std::atomic<bool> m_detectionEnabled{false};
 
-    // 最新检测结果（原子替换，供跳帧期间复用）
-    std::mutex   m_detMutex;
-    DetectionList m_latestDetections;
+    // 最近取得的检测结果（仅帧线程访问，坐标为源分辨率）
+    DetectionResult  m_lastResult;
+    SortTracker      m_tracker;
+    DetectionList    m_tracked;              // 当前帧的检测/跟踪框（源分辨率）
+    std::atomic<bool> m_trackingEnabled{true};
+    MotionGate       m_motionGate;
+    // 自上次门控评估以来源报告的变化区域（ScreenSource）；为真时变化范围未知，改用帧差
+    std::vector<cv::Rect> m_gateDirty;
+    bool             m_gateDirtyFull = true;
+    bool             m_sceneStatic   = false;   // 最近一次门控判定画面静止：跟踪器原地保持而非外推
+    std::atomic<bool> m_motionGating{false};
+    std::chrono::steady_clock::time_point m_openTime;
 
     // ──── 状态 ────
     bool  m_paused    = false;
     bool  m_recording = false;
     cv::Mat m_lastOrigFrame;
     cv::Mat m_lastProcessedFrame;
+    QString m_outputDir;
+
+    // ──── 代理分辨率（UI 线程写，帧线程读） ────
+    std::atomic<double> m_procScale{1.0};
+    std::atomic<bool>   m_fullResSinks{true};
+    // 缩小后的源帧：显示邮箱三个槽位 + 正在处理的一帧
+    static constexpr std::size_t kProxyPoolCapacity = 4;
+    FramePool           m_proxyPool{kProxyPoolCapacity};
+
+    // ──── 显示交接（帧线程生产，GUI 线程消费） ────
+    TripleBuffer<DisplayFrame> m_display;
+    std::atomic<bool>          m_displayPending{false};   // 已发出通知且 GUI 尚未取帧
 
     // ──── FPS 统计 ────
     struct FpsCounter {
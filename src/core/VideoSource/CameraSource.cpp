@@ -0,0 +1,68 @@
+#include "CameraSource.h"
+
+CameraSource::CameraSource(int deviceIndex, int width, int height, double fps)
+    : m_deviceIndex(deviceIndex)
+    , m_reqWidth(width)
+    , m_reqHeight(height)
+    , m_reqFps(fps)
+{}
+
+CameraSource::~CameraSource()
+{
+    close();
+}
+
+bool CameraSource::open()
+{
+#ifdef _WIN32
+    const int api = cv::CAP_DSHOW;   // MSMF 打开摄像头明显更慢
+#else
+    const int api = cv::CAP_ANY;
+#endif
+    if (!m_cap.open(m_deviceIndex, api))
+        return false;
+
+    if (m_reqWidth > 0)  m_cap.set(cv::CAP_PROP_FRAME_WIDTH,  m_reqWidth);
+    if (m_reqHeight > 0) m_cap.set(cv::CAP_PROP_FRAME_HEIGHT, m_reqHeight);
+    if (m_reqFps > 0.0)  m_cap.set(cv::CAP_PROP_FPS,          m_reqFps);
+
+    // 驱动侧只保留最新帧，避免延迟累积
+    m_cap.set(cv::CAP_PROP_BUFFERSIZE, 1);
+    return true;
+}
+
+bool CameraSource::read(cv::Mat& frame)
+{
+    return m_cap.isOpened() && m_cap.read(frame) && !frame.empty();
+}
+
+void CameraSource::close()
+{
+    m_cap.release();
+}
+
+bool CameraSource::isOpened() const
+{
+    return m_cap.isOpened();
+}
+
+int CameraSource::width() const
+{
+    return static_cast<int>(m_cap.get(cv::CAP_PROP_FRAME_WIDTH));
+}
+
+int CameraSource::height() const
+{
+    return static_cast<int>(m_cap.get(cv::CAP_PROP_FRAME_HEIGHT));
+}
+
+double CameraSource::fps() const
+{
+    const double f = m_cap.get(cv::CAP_PROP_FPS);
+    return f > 0.0 ? f : 30.0;
+}
+
+std::string CameraSource::description() const
+{
+    return "摄像头 #" + std::to_string(m_deviceIndex);
+}
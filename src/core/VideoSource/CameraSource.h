@@ -0,0 +1,27 @@
+#pragma once
+#include "VideoSource.h"
+#include <opencv2/videoio.hpp>
+
+class CameraSource : public VideoSource {
+public:
+    // width/height/fps 为 0 时使用设备默认值
+    explicit CameraSource(int deviceIndex, int width = 0, int height = 0, double fps = 0.0);
+    ~CameraSource() override;
+
+    bool open() override;
+    bool read(cv::Mat& frame) override;
+    void close() override;
+    bool isOpened() const override;
+
+    int    width()  const override;
+    int    height() const override;
+    double fps()    const override;
+    std::string description() const override;
+
+private:
+    int              m_deviceIndex;
+    int              m_reqWidth;
+    int              m_reqHeight;
+    double           m_reqFps;
+    cv::VideoCapture m_cap;
+};
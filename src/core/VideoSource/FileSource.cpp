@@ -0,0 +1,245 @@
+#include "FileSource.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 目标在当前位置之后且不超过该时长时顺序 grab 前进，不触发重新定位
+constexpr double kForwardDecodeMsec = 2000.0;
+// 精确跳转时先落在目标之前的余量；后端越过目标时加倍重试
+constexpr double kSeekPrerollMsec   = 1000.0;
+constexpr int    kSeekAttempts      = 4;
+// 比较 grab 得到的 pts 与索引 pts 时的容差（索引由同一后端的 CAP_PROP_POS_MSEC 生成）
+constexpr double kPtsToleranceMsec  = 0.5;
+constexpr int    kIndexNice         = 10;
+
+// 建索引需解码全文件，降低该线程优先级，避免与播放、检测争用 CPU
+void lowerCurrentThreadPriority()
+{
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined(__linux__)
+    // Linux 的 nice 值按线程生效
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), kIndexNice);
+#endif
+}
+
+} // namespace
+
+FileSource::FileSource(std::string path)
+    : m_path(std::move(path))
+{}
+
+FileSource::~FileSource()
+{
+    close();
+}
+
+bool FileSource::open()
+{
+    close();
+    if (!m_cap.open(m_path))
+        return false;
+    m_nextFrame = 0;
+
+    FrameIndex cached;
+    if (cached.load(m_path)) {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_index      = std::move(cached);
+        m_indexReady = true;
+    } else {
+        buildIndexAsync();
+    }
+    return true;
+}
+
+void FileSource::buildIndexAsync()
+{
+    // 独立的 VideoCapture 扫描全文件，不占用播放解码器。扫描即一次完整解码，
+    // 长视频可达数分钟；期间跳转退回按时间定位
+    m_cancelIndex = false;
+    m_indexThread = std::thread([this] {
+        lowerCurrentThreadPriority();
+        FrameIndex index;
+        if (!index.build(m_path, m_cancelIndex))
+            return;
+        index.save(m_path);
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_index      = std::move(index);
+        m_indexReady = true;
+    });
+}
+
+bool FileSource::indexReady() const
+{
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    return m_indexReady;
+}
+
+bool FileSource::read(cv::Mat& frame)
+{
+    if (!m_cap.isOpened())
+        return false;
+    const bool ok = m_grabbed ? m_cap.retrieve(frame) : m_cap.read(frame);
+    m_grabbed = false;
+    if (!ok || frame.empty())
+        return false;
+    if (m_nextFrame >= 0)
+        ++m_nextFrame;
+    return true;
+}
+
+void FileSource::close()
+{
+    m_cancelIndex = true;
+    if (m_indexThread.joinable())
+        m_indexThread.join();
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_index      = FrameIndex{};
+        m_indexReady = false;
+    }
+    m_cap.release();
+    m_grabbed = false;
+}
+
+bool FileSource::isOpened() const
+{
+    return m_cap.isOpened();
+}
+
+int FileSource::width() const
+{
+    return static_cast<int>(m_cap.get(cv::CAP_PROP_FRAME_WIDTH));
+}
+
+int FileSource::height() const
+{
+    return static_cast<int>(m_cap.get(cv::CAP_PROP_FRAME_HEIGHT));
+}
+
+double FileSource::fps() const
+{
+    const double f = m_cap.get(cv::CAP_PROP_FPS);
+    return f > 0.0 ? f : 30.0;
+}
+
+std::string FileSource::description() const
+{
+    return "文件: " + m_path;
+}
+
+bool FileSource::seek(double posMsec)
+{
+    if (!m_cap.isOpened())
+        return false;
+
+    int    target  = -1;
+    double current = 0.0;
+    double wanted  = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        if (m_indexReady) {
+            target  = m_index.frameAt(posMsec);
+            wanted  = m_index.ptsOf(target);
+            current = m_nextFrame > 0 ? m_index.ptsOf(m_nextFrame - 1) : 0.0;
+        }
+    }
+
+    // 索引未就绪：退回按时间定位（按平均帧率换算，VFR 文件有偏差）
+    if (target < 0) {
+        m_grabbed   = false;
+        m_nextFrame = -1;
+        return m_cap.set(cv::CAP_PROP_POS_MSEC, posMsec);
+    }
+
+    if (m_grabbed && target == m_nextFrame)
+        return true;
+
+    // 近距离前跳：顺序 grab 至目标帧（grab 仍解码每帧，只省去 BGR 转换）
+    if (m_nextFrame >= 0 && target >= m_nextFrame && wanted - current <= kForwardDecodeMsec) {
+        if (m_grabbed) {   // 已 grab 的帧不是目标，跳过
+            m_grabbed = false;
+            ++m_nextFrame;
+        }
+        while (m_nextFrame < target && m_cap.grab())
+            ++m_nextFrame;
+        return m_nextFrame == target;
+    }
+
+    return seekExact(target, wanted);
+}
+
+bool FileSource::seekExact(int target, double wanted)
+{
+    // CAP_PROP_POS_FRAMES/POS_MSEC 在后端内按平均帧率换算时间戳，VFR 文件会落在邻近帧。
+    // 先跳到目标之前（后端落在其前的关键帧后解码），再以索引 pts 逐帧核对到目标帧
+    m_grabbed   = false;
+    m_nextFrame = -1;
+    double preroll = kSeekPrerollMsec;
+    for (int attempt = 0; attempt < kSeekAttempts; ++attempt, preroll *= 2.0) {
+        const double start = std::max(0.0, wanted - preroll);
+        if (!m_cap.set(cv::CAP_PROP_POS_MSEC, start))
+            return false;
+
+        bool overshoot = false;
+        while (m_cap.grab()) {
+            int frame;
+            {
+                std::lock_guard<std::mutex> lock(m_indexMutex);
+                frame = m_index.frameAt(m_cap.get(cv::CAP_PROP_POS_MSEC) + kPtsToleranceMsec);
+            }
+            if (frame < target)
+                continue;
+            if (frame == target) {
+                m_grabbed   = true;
+                m_nextFrame = target;
+                return true;
+            }
+            overshoot = true;   // 落点已越过目标，加大余量重试
+            break;
+        }
+        if (!overshoot || start == 0.0)
+            break;
+    }
+
+    // 仍无法落到目标帧：按帧号定位（不保证精确）
+    if (!m_cap.set(cv::CAP_PROP_POS_FRAMES, target))
+        return false;
+    m_nextFrame = target;
+    return true;
+}
+
+double FileSource::posMsec() const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        if (m_indexReady && m_nextFrame > 0)
+            return m_index.ptsOf(m_nextFrame - 1);
+    }
+    return m_cap.get(cv::CAP_PROP_POS_MSEC);
+}
+
+double FileSource::durationMsec() const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        if (m_indexReady)
+            return m_index.durationMsec();
+    }
+    const double frames = m_cap.get(cv::CAP_PROP_FRAME_COUNT);
+    return frames > 0.0 ? frames * 1000.0 / fps() : 0.0;
+}
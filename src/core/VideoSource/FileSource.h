@@ -0,0 +1,47 @@
+#pragma once
+#include "VideoSource.h"
+#include "FrameIndex.h"
+#include <opencv2/videoio.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+class FileSource : public VideoSource {
+public:
+    explicit FileSource(std::string path);
+    ~FileSource() override;
+
+    bool open() override;
+    bool read(cv::Mat& frame) override;
+    void close() override;
+    bool isOpened() const override;
+
+    int    width()  const override;
+    int    height() const override;
+    double fps()    const override;
+    std::string description() const override;
+
+    bool   seek(double posMsec) override;
+    double posMsec() const override;
+    double durationMsec() const override;
+
+    // 帧索引是否就绪（首次打开时后台扫描，之后从缓存读取）
+    bool indexReady() const;
+
+private:
+    void buildIndexAsync();
+    // 按索引精确定位：先按时间跳到目标之前，再逐帧 grab 到目标帧（其像素留待下一次 read 取出）。
+    // 可能解码数秒视频，经 ThreadedSource 包装时在采集线程执行
+    bool seekExact(int target, double wanted);
+
+    std::string      m_path;
+    cv::VideoCapture m_cap;
+    int              m_nextFrame = 0;   // 下一次 read() 的帧号；-1 = 未知（无索引时按时间跳转后）
+    bool             m_grabbed   = false;   // m_nextFrame 已 grab 未 retrieve（精确跳转后）
+
+    mutable std::mutex m_indexMutex;
+    FrameIndex         m_index;
+    bool               m_indexReady = false;
+    std::atomic<bool>  m_cancelIndex{false};
+    std::thread        m_indexThread;
+};
@@ -0,0 +1,141 @@
+#include "FrameIndex.h"
+#include <opencv2/videoio.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr char          kMagic[8] = {'R', 'V', 'S', 'I', 'D', 'X', '0', '1'};
+constexpr std::uint64_t kMaxFrames = 1ull << 28;   // 防御损坏文件导致的超大分配
+
+} // namespace
+
+std::filesystem::path FrameIndex::cachePathFor(const std::filesystem::path& video)
+{
+    std::filesystem::path p = video;
+    p += ".rvsidx";
+    return p;
+}
+
+bool FrameIndex::stampOf(const std::filesystem::path& video, Stamp& out)
+{
+    std::error_code ec;
+    out.size = std::filesystem::file_size(video, ec);
+    if (ec)
+        return false;
+    const auto t = std::filesystem::last_write_time(video, ec);
+    if (ec)
+        return false;
+    out.mtime = static_cast<std::int64_t>(t.time_since_epoch().count());
+    return true;
+}
+
+bool FrameIndex::load(const std::filesystem::path& video)
+{
+    Stamp stamp;
+    if (!stampOf(video, stamp))
+        return false;
+
+    std::ifstream in(cachePathFor(video), std::ios::binary);
+    if (!in)
+        return false;
+
+    char          magic[sizeof(kMagic)];
+    Stamp         saved;
+    std::uint64_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&saved.size), sizeof(saved.size));
+    in.read(reinterpret_cast<char*>(&saved.mtime), sizeof(saved.mtime));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0
+        || saved.size != stamp.size || saved.mtime != stamp.mtime
+        || count == 0 || count > kMaxFrames)
+        return false;
+
+    std::vector<double> pts(static_cast<std::size_t>(count));
+    in.read(reinterpret_cast<char*>(pts.data()),
+            static_cast<std::streamsize>(pts.size() * sizeof(double)));
+    if (!in)
+        return false;
+    m_pts = std::move(pts);
+    return true;
+}
+
+bool FrameIndex::save(const std::filesystem::path& video) const
+{
+    Stamp stamp;
+    if (m_pts.empty() || !stampOf(video, stamp))
+        return false;
+
+    // 先写临时文件再改名，中途失败不会留下半截缓存
+    const std::filesystem::path target = cachePathFor(video);
+    std::filesystem::path tmp = target;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        const std::uint64_t count = m_pts.size();
+        out.write(kMagic, sizeof(kMagic));
+        out.write(reinterpret_cast<const char*>(&stamp.size), sizeof(stamp.size));
+        out.write(reinterpret_cast<const char*>(&stamp.mtime), sizeof(stamp.mtime));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(m_pts.data()),
+                  static_cast<std::streamsize>(m_pts.size() * sizeof(double)));
+        if (!out)
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, target, ec);
+    if (ec)
+        std::filesystem::remove(tmp, ec);
+    return !ec;
+}
+
+bool FrameIndex::build(const std::filesystem::path& video, const std::atomic<bool>& cancel)
+{
+    cv::VideoCapture cap;
+    if (!cap.open(video.string()))
+        return false;
+
+    std::vector<double> pts;
+    const double hint = cap.get(cv::CAP_PROP_FRAME_COUNT);
+    if (hint > 0.0 && hint < static_cast<double>(kMaxFrames))
+        pts.reserve(static_cast<std::size_t>(hint));
+
+    double last = 0.0;
+    while (cap.grab()) {
+        if (cancel.load(std::memory_order_relaxed))
+            return false;
+        // 个别容器的 pts 存在乱序/缺失，保持单调以便二分查找
+        last = std::max(last, cap.get(cv::CAP_PROP_POS_MSEC));
+        pts.push_back(last);
+    }
+    if (pts.empty())
+        return false;
+    m_pts = std::move(pts);
+    return true;
+}
+
+double FrameIndex::ptsOf(int frame) const
+{
+    if (m_pts.empty())
+        return 0.0;
+    frame = std::clamp(frame, 0, frameCount() - 1);
+    return m_pts[static_cast<std::size_t>(frame)];
+}
+
+int FrameIndex::frameAt(double posMsec) const
+{
+    const auto it = std::upper_bound(m_pts.begin(), m_pts.end(), posMsec);
+    return std::max(0, static_cast<int>(it - m_pts.begin()) - 1);
+}
+
+double FrameIndex::durationMsec() const
+{
+    if (m_pts.empty())
+        return 0.0;
+    const double tail = m_pts.size() > 1 ? m_pts.back() - m_pts[m_pts.size() - 2] : 0.0;
+    return m_pts.back() + tail;
+}
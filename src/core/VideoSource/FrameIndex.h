@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// 视频逐帧时间戳索引，缓存于视频文件旁（<文件名>.rvsidx），以文件大小与修改时间校验。
+// 跳转时按时间戳二分定位到精确帧号，避免 CAP_PROP_POS_MSEC 按平均帧率换算的误差
+class FrameIndex {
+public:
+    static std::filesystem::path cachePathFor(const std::filesystem::path& video);
+
+    // 读取缓存；缓存不存在或与视频文件不匹配返回 false
+    bool load(const std::filesystem::path& video);
+    bool save(const std::filesystem::path& video) const;
+
+    // 扫描整个文件；cancel 置位时中止并返回 false。
+    // 多数后端（FFmpeg）的 grab 仍会完整解码每帧，只省去 BGR 转换，耗时接近一次完整播放的解码，
+    // 调用方应在后台低优先级线程执行（见 FileSource::buildIndexAsync）
+    bool build(const std::filesystem::path& video, const std::atomic<bool>& cancel);
+
+    bool   empty() const      { return m_pts.empty(); }
+    int    frameCount() const { return static_cast<int>(m_pts.size()); }
+    double ptsOf(int frame) const;               // 越界时截断到首/末帧
+    int    frameAt(double posMsec) const;        // pts ≤ posMsec 的最后一帧
+    double durationMsec() const;                 // 末帧 pts + 末帧时长
+
+private:
+    struct Stamp {
+        std::uint64_t size  = 0;
+        std::int64_t  mtime = 0;
+    };
+    static bool stampOf(const std::filesystem::path& video, Stamp& out);
+
+    std::vector<double> m_pts;   // 各帧呈现时间（ms），单调不减
+};
@@ -0,0 +1,339 @@
+#include "ScreenSource.h"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <thread>
+
+// X11 头文件定义了 Bool/Status/None 等宏，须在其它头文件之后包含
+#ifdef RVSFDT_HAVE_X11
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/Xdamage.h>
+#include <X11/extensions/Xfixes.h>
+#include <poll.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+namespace {
+
+// 输出缓冲区数：采集环的槽位（实时源 3 个）与显示/检测各持有一帧时仍有空闲
+constexpr std::size_t kMaxBuffers    = 6;
+constexpr std::size_t kMaxStaleRects = 64;   // 超过时该缓冲区改为整帧写入
+
+} // namespace
+
+#ifdef RVSFDT_HAVE_X11
+
+namespace {
+
+constexpr int kPollSliceMs = 50;   // 等待变化时检查 interrupt() 的间隔
+
+cv::Rect boundingBox(const std::vector<cv::Rect>& rects)
+{
+    cv::Rect box;
+    for (const cv::Rect& r : rects)
+        box = box.empty() ? r : (box | r);
+    return box;
+}
+
+} // namespace
+
+struct ScreenSource::X11Capture {
+    Display*        display = nullptr;
+    Window          root    = 0;
+    XImage*         image   = nullptr;
+    XShmSegmentInfo shm{};
+    bool            attached = false;
+    Damage          damage  = 0;
+    XserverRegion   parts   = 0;
+    int             damageEvent = 0;
+    bool            damaged = true;   // 首帧整帧抓取
+    Visual*         visual  = nullptr;
+    int             depth   = 0;
+
+    ~X11Capture()
+    {
+        if (!display)
+            return;
+        if (parts)
+            XFixesDestroyRegion(display, parts);
+        if (damage)
+            XDamageDestroy(display, damage);
+        if (attached)
+            XShmDetach(display, &shm);
+        if (image)
+            XDestroyImage(image);   // data 指向共享内存，由 shmdt 释放
+        if (shm.shmaddr && shm.shmaddr != reinterpret_cast<char*>(-1))
+            shmdt(shm.shmaddr);
+        XCloseDisplay(display);
+    }
+
+    bool open(cv::Rect& region)
+    {
+        display = XOpenDisplay(nullptr);   // 按 DISPLAY 环境变量连接（含 Xvfb）
+        if (!display)
+            return false;
+
+        int ignore = 0, errorBase = 0;
+        if (!XShmQueryExtension(display)
+            || !XDamageQueryExtension(display, &damageEvent, &errorBase)
+            || !XFixesQueryExtension(display, &ignore, &errorBase))
+            return false;
+
+        const int screen = DefaultScreen(display);
+        root = RootWindow(display, screen);
+        const cv::Rect screenRect(0, 0, DisplayWidth(display, screen), DisplayHeight(display, screen));
+        region = region.empty() ? screenRect : (region & screenRect);
+        if (region.empty())
+            return false;
+
+        // 共享内存图像：XShmGetImage 由服务端直接写入本进程内存，无套接字传输
+        visual = DefaultVisual(display, screen);
+        depth  = DefaultDepth(display, screen);
+        image = XShmCreateImage(display, DefaultVisual(display, screen), DefaultDepth(display, screen),
+                                ZPixmap, nullptr, &shm,
+                                static_cast<unsigned>(region.width), static_cast<unsigned>(region.height));
+        if (!image || image->bits_per_pixel != 32)
+            return false;   // 仅支持 24/32 位 TrueColor（BGRX）
+
+        shm.shmid = shmget(IPC_PRIVATE, static_cast<std::size_t>(image->bytes_per_line) * image->height,
+                           IPC_CREAT | 0600);
+        if (shm.shmid < 0)
+            return false;
+        shm.shmaddr  = image->data = static_cast<char*>(shmat(shm.shmid, nullptr, 0));
+        shm.readOnly = False;
+        if (shm.shmaddr == reinterpret_cast<char*>(-1)) {
+            shmctl(shm.shmid, IPC_RMID, nullptr);
+            return false;
+        }
+        attached = XShmAttach(display, &shm);
+        XSync(display, False);
+        shmctl(shm.shmid, IPC_RMID, nullptr);   // 双方 detach 后自动回收
+        if (!attached)
+            return false;
+
+        damage = XDamageCreate(display, root, XDamageReportNonEmpty);
+        parts  = XFixesCreateRegion(display, nullptr, 0);
+        return damage && parts;
+    }
+
+    // 取出并清空累计的损坏区域，转换为 region 内坐标
+    std::vector<cv::Rect> takeDamage(const cv::Rect& region)
+    {
+        XDamageSubtract(display, damage, 0, parts);
+        int count = 0;
+        XRectangle* rects = XFixesFetchRegion(display, parts, &count);
+        std::vector<cv::Rect> out;
+        for (int i = 0; i < count; ++i) {
+            const cv::Rect r = cv::Rect(rects[i].x, rects[i].y, rects[i].width, rects[i].height) & region;
+            if (!r.empty())
+                out.push_back(r - region.tl());
+        }
+        if (rects)
+            XFree(rects);
+        return out;
+    }
+
+    // 只读取区域内 box（区域坐标）覆盖的像素：以 box 尺寸的图像头指向同一共享内存段，
+    // 服务端按该尺寸紧凑写入段首。返回指向段内像素的 BGRX 视图，失败返回空
+    cv::Mat grab(const cv::Rect& region, const cv::Rect& box)
+    {
+        if (box.size() == region.size()) {
+            if (!XShmGetImage(display, root, image, region.x, region.y, AllPlanes))
+                return {};
+            return cv::Mat(region.height, region.width, CV_8UC4,
+                           image->data, static_cast<std::size_t>(image->bytes_per_line));
+        }
+
+        XImage* sub = XShmCreateImage(display, visual, static_cast<unsigned>(depth), ZPixmap,
+                                      shm.shmaddr, &shm,
+                                      static_cast<unsigned>(box.width), static_cast<unsigned>(box.height));
+        if (!sub)
+            return {};
+        const bool ok = XShmGetImage(display, root, sub, region.x + box.x, region.y + box.y, AllPlanes);
+        const std::size_t stride = static_cast<std::size_t>(sub->bytes_per_line);
+        XDestroyImage(sub);   // 只释放图像头，像素在共享内存段内
+        if (!ok)
+            return {};
+        return cv::Mat(box.height, box.width, CV_8UC4, shm.shmaddr, stride);
+    }
+
+    // 处理挂起事件；有 DamageNotify 时置位 damaged
+    void drainEvents()
+    {
+        while (XPending(display) > 0) {
+            XEvent ev;
+            XNextEvent(display, &ev);
+            if (ev.type == damageEvent + XDamageNotify)
+                damaged = true;
+        }
+    }
+
+    bool waitEvents(int timeoutMs)
+    {
+        pollfd pfd{ConnectionNumber(display), POLLIN, 0};
+        return poll(&pfd, 1, timeoutMs) > 0;
+    }
+};
+
+#else
+
+struct ScreenSource::X11Capture {};
+
+#endif
+
+ScreenSource::ScreenSource(cv::Rect region, double fps)
+    : m_region(region)
+    , m_fps(fps > 0.0 ? fps : 30.0)
+{}
+
+ScreenSource::~ScreenSource()
+{
+    close();
+}
+
+bool ScreenSource::open()
+{
+    close();
+#ifdef RVSFDT_HAVE_X11
+    auto x11 = std::make_unique<X11Capture>();
+    cv::Rect region = m_region;
+    if (!x11->open(region))
+        return false;
+
+    m_region      = region;
+    m_x11         = std::move(x11);
+    m_interrupted = false;
+    m_buffers.clear();
+    m_started     = false;
+    m_dirty.clear();
+    m_lastFrame   = {};
+    m_opened      = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ScreenSource::read(cv::Mat& frame)
+{
+#ifdef RVSFDT_HAVE_X11
+    if (!m_opened)
+        return false;
+
+    // 限速：两帧间隔不少于 1/fps，期间的变化累积到下一帧
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / m_fps));
+    const auto due = m_lastFrame + interval;
+    while (std::chrono::steady_clock::now() < due) {
+        if (m_interrupted)
+            return false;
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            due - std::chrono::steady_clock::now());
+        std::this_thread::sleep_for(std::min(left, std::chrono::milliseconds(kPollSliceMs)));
+    }
+
+    // 等待屏幕变化；区域外的变化不产出帧
+    const bool first = !m_started;
+    std::vector<cv::Rect> dirty;
+    for (;;) {
+        if (m_interrupted)
+            return false;
+        m_x11->drainEvents();
+        if (m_x11->damaged) {
+            m_x11->damaged = false;
+            dirty = m_x11->takeDamage(m_region);
+            if (first || !dirty.empty())
+                break;
+        }
+        m_x11->waitEvents(kPollSliceMs);
+    }
+    if (first)
+        dirty.clear();   // 首帧视为整帧变化
+
+    // 取空闲缓冲区；待写入区域 = 该缓冲区积压的变化 + 本次变化，只读取其外接区域
+    Buffer* buf = acquireBuffer();
+    const cv::Rect full(0, 0, m_region.width, m_region.height);
+    const bool wholeFrame = !buf || buf->full || dirty.empty();
+    std::vector<cv::Rect> update;
+    if (!wholeFrame) {
+        update = buf->stale;
+        update.insert(update.end(), dirty.begin(), dirty.end());
+    }
+    const cv::Rect box = wholeFrame ? full : (boundingBox(update) & full);
+
+    const cv::Mat bgrx = m_x11->grab(m_region, box);
+    if (bgrx.empty())
+        return false;
+
+    cv::Mat out = buf ? buf->frame : cv::Mat();
+    if (wholeFrame) {
+        cv::cvtColor(bgrx, out, cv::COLOR_BGRA2BGR);   // 缓冲区尺寸一致时不重新分配
+        if (buf)
+            buf->frame = out;
+    } else {
+        for (const cv::Rect& r : update) {
+            cv::Mat roi = out(r);
+            cv::cvtColor(bgrx(r - box.tl()), roi, cv::COLOR_BGRA2BGR);
+        }
+    }
+    markStale(buf, dirty);
+    m_started = true;
+
+    m_dirty     = std::move(dirty);
+    m_lastFrame = std::chrono::steady_clock::now();
+    frame       = out;
+    return true;
+#else
+    (void)frame;
+    return false;
+#endif
+}
+
+ScreenSource::Buffer* ScreenSource::acquireBuffer()
+{
+    for (Buffer& b : m_buffers)
+        if (b.frame.u == nullptr || b.frame.u->refcount == 1)
+            return &b;
+    if (m_buffers.size() < kMaxBuffers) {
+        m_buffers.emplace_back();
+        return &m_buffers.back();
+    }
+    return nullptr;   // 临时分配整帧，不入轮换
+}
+
+void ScreenSource::markStale(const Buffer* written, const std::vector<cv::Rect>& dirty)
+{
+    for (Buffer& b : m_buffers) {
+        if (&b == written) {
+            b.stale.clear();
+            b.full = b.frame.empty();
+        } else if (!b.full) {
+            // dirty 为空表示整帧变化
+            b.stale.insert(b.stale.end(), dirty.begin(), dirty.end());
+            b.full = dirty.empty() || b.stale.size() > kMaxStaleRects;
+            if (b.full)
+                b.stale.clear();
+        }
+    }
+}
+
+void ScreenSource::close()
+{
+    m_x11.reset();
+    m_buffers.clear();
+    m_started = false;
+    m_dirty.clear();
+    m_opened = false;
+}
+
+bool ScreenSource::isOpened() const
+{
+    return m_opened;
+}
+
+std::string ScreenSource::description() const
+{
+    return "屏幕捕获";
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "VideoSource.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+// 屏幕区域捕获。Linux 下（RVSFDT_HAVE_X11）使用 X11 MIT-SHM 共享内存图像与 XDamage 变化跟踪：
+// 画面静止时 read() 阻塞等待而不产出帧，变化时只读取脏矩形的外接区域、只转换脏矩形覆盖的像素。
+// 输出帧取自自有的轮换缓冲区，各缓冲区记录自上次写入以来的变化区域，复用时只补齐这些区域。
+// 可在 Xvfb 下运行（DISPLAY 指向虚拟显示，见 tests/ScreenSourceTest.cpp）。其它平台 open() 始终失败
+class ScreenSource : public VideoSource {
+public:
+    // region 为空表示全屏
+    explicit ScreenSource(cv::Rect region = {}, double fps = 30.0);
+    ~ScreenSource() override;
+
+    bool open() override;
+    // 等待下一次屏幕变化（且距上一帧不少于 1/fps）；关闭或被 interrupt() 唤醒时返回 false
+    bool read(cv::Mat& frame) override;
+    void close() override;
+    bool isOpened() const override;
+
+    int    width()  const override { return m_region.width; }
+    int    height() const override { return m_region.height; }
+    double fps()    const override { return m_fps; }
+    std::string description() const override;
+
+    std::vector<cv::Rect> dirtyRegions() const override { return m_dirty; }
+    void interrupt() override { m_interrupted = true; }
+
+private:
+    struct X11Capture;   // X11 类型不进入头文件（其宏与 Qt/OpenCV 冲突）
+
+    // 轮换输出缓冲区；仅被本对象引用（refcount == 1）时可复写
+    struct Buffer {
+        cv::Mat               frame;
+        std::vector<cv::Rect> stale;        // 自上次写入以来屏幕变化、尚未补齐的区域
+        bool                  full = true;  // 需整帧写入（新建或变化区域过多）
+    };
+    Buffer* acquireBuffer();                // 全部被下游持有时返回 nullptr
+    void    markStale(const Buffer* written, const std::vector<cv::Rect>& dirty);
+
+    cv::Rect m_region;
+    double   m_fps;
+    bool     m_opened = false;
+    bool     m_started = false;   // 已产出首帧
+
+    std::vector<Buffer>   m_buffers;
+    std::vector<cv::Rect> m_dirty;   // 最近一帧的变化区域（区域坐标）
+    std::atomic<bool>     m_interrupted{false};
+    std::chrono::steady_clock::time_point m_lastFrame;
+    std::unique_ptr<X11Capture> m_x11;
+};
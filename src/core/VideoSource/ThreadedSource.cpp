@@ -0,0 +1,303 @@
+#include "ThreadedSource.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+constexpr int kLiveSlots = 3;
+constexpr int kFileSlots = 8;
+// 每个槽位的缓冲区数：下游（显示、检测、录制队列）持有上一帧时轮换到下一块，稳态零分配
+constexpr std::size_t kBuffersPerSlot = 3;
+
+} // namespace
+
+ThreadedSource::ThreadedSource(std::unique_ptr<VideoSource> inner, CapturePolicy policy, int slots)
+    : m_inner(std::move(inner))
+    , m_policy(policy)
+    , m_slotRequest(slots)
+    , m_description(m_inner->description())
+{}
+
+ThreadedSource::~ThreadedSource()
+{
+    close();
+}
+
+bool ThreadedSource::open()
+{
+    close();
+    if (!m_inner->open())
+        return false;
+
+    m_width       = m_inner->width();
+    m_height      = m_inner->height();
+    m_fps         = m_inner->fps();
+    m_duration    = m_inner->durationMsec();
+    if (m_policy == CapturePolicy::Auto)
+        m_policy = (m_duration > 0.0) ? CapturePolicy::Lossless : CapturePolicy::LatestOnly;
+    const int slots = m_slotRequest > 0 ? m_slotRequest
+                    : (m_policy == CapturePolicy::Lossless ? kFileSlots : kLiveSlots);
+    m_slots.assign(static_cast<std::size_t>(std::max(2, slots)), Slot{});
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready.clear();
+        m_free.clear();
+        for (int i = static_cast<int>(m_slots.size()) - 1; i >= 0; --i)
+            m_free.push_back(i);
+        m_stop   = false;
+        m_paused = false;
+        m_eof    = false;
+        m_pos    = 0.0;
+        m_stats  = CaptureStats{};
+        m_dirty.clear();
+        m_carryPending = false;
+        m_seekPending  = false;
+    }
+    m_thread = std::thread(&ThreadedSource::captureLoop, this);
+    return true;
+}
+
+void ThreadedSource::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_inner->interrupt();   // 屏幕源等会在 read() 中等待变化
+    m_readyCv.notify_all();
+    m_freeCv.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+    m_inner->close();
+}
+
+bool ThreadedSource::isOpened() const
+{
+    return m_inner->isOpened();
+}
+
+bool ThreadedSource::finished() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_eof && m_ready.empty();
+}
+
+CaptureStats ThreadedSource::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+std::vector<cv::Rect> ThreadedSource::dirtyRegions() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dirty;
+}
+
+void ThreadedSource::mergeDirty(std::vector<cv::Rect>& into, const std::vector<cv::Rect>& from)
+{
+    if (into.empty() || from.empty())
+        into.clear();
+    else
+        into.insert(into.end(), from.begin(), from.end());
+}
+
+double ThreadedSource::posMsec() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pos;
+}
+
+bool ThreadedSource::read(cv::Mat& frame)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto timeout = std::chrono::milliseconds(m_readTimeoutMs.load());
+    if (!m_readyCv.wait_for(lock, timeout, [this] { return m_stop || m_eof || !m_ready.empty(); })
+        || m_ready.empty())
+        return false;
+
+    // 实时源只取最新帧，其余排队帧计为丢弃；文件源按顺序取最早的帧
+    if (m_policy == CapturePolicy::LatestOnly) {
+        while (m_ready.size() > 1) {
+            const int dropped = m_ready.front();
+            m_ready.pop_front();
+            mergeDirty(m_slots[static_cast<std::size_t>(m_ready.back())].dirty,
+                       m_slots[static_cast<std::size_t>(dropped)].dirty);
+            m_free.push_back(dropped);
+            ++m_stats.dropped;
+        }
+    }
+    const int idx = m_ready.front();
+    m_ready.pop_front();
+
+    // 浅拷贝交出；采集线程复用该槽位前会检查引用计数
+    Slot& slot = m_slots[static_cast<std::size_t>(idx)];
+    frame   = slot.frame;
+    m_pos   = slot.posMsec;
+    m_dirty = slot.dirty;
+    ++m_stats.consumed;
+    m_free.push_back(idx);
+    lock.unlock();
+    m_freeCv.notify_one();
+    return true;
+}
+
+void ThreadedSource::pause()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paused = true;
+}
+
+void ThreadedSource::resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_paused = false;
+        // 实时源恢复时丢弃暂停前的积压帧
+        if (m_policy == CapturePolicy::LatestOnly)
+            flushReady();
+    }
+    m_freeCv.notify_all();
+}
+
+bool ThreadedSource::seek(double posMsec)
+{
+    if (m_duration <= 0.0)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;   // 采集线程正在读取的帧作废
+        m_seekPending = true;
+        m_seekTarget  = posMsec;
+        flushReady();
+        m_eof = false;
+        m_pos = posMsec;
+    }
+    m_freeCv.notify_all();
+    return true;
+}
+
+void ThreadedSource::flushReady()
+{
+    // 丢弃的帧变化区域未知，下一帧按整帧变化处理
+    if (!m_ready.empty()) {
+        m_carry.clear();
+        m_carryPending = true;
+    }
+    while (!m_ready.empty()) {
+        m_free.push_back(m_ready.front());
+        m_ready.pop_front();
+    }
+}
+
+int ThreadedSource::acquireSlot(std::unique_lock<std::mutex>& lock)
+{
+    for (;;) {
+        m_freeCv.wait(lock, [this] {
+            return m_stop || (!m_paused && !m_eof
+                              && (!m_free.empty() || m_policy == CapturePolicy::LatestOnly));
+        });
+        if (m_stop)
+            return -1;
+
+        if (!m_free.empty()) {
+            const int idx = m_free.back();
+            m_free.pop_back();
+            return idx;
+        }
+        // 实时源槽位用尽：覆盖最旧的未消费帧，采集永不阻塞
+        if (!m_ready.empty()) {
+            const int idx = m_ready.front();
+            m_ready.pop_front();
+            const std::vector<cv::Rect>& lost = m_slots[static_cast<std::size_t>(idx)].dirty;
+            if (!m_ready.empty()) {
+                mergeDirty(m_slots[static_cast<std::size_t>(m_ready.front())].dirty, lost);
+            } else if (m_carryPending) {
+                mergeDirty(m_carry, lost);
+            } else {
+                m_carry        = lost;
+                m_carryPending = true;
+            }
+            ++m_stats.dropped;
+            return idx;
+        }
+        // 全部槽位处于 read() 与释放之间的瞬态，稍后重试
+        m_freeCv.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+int ThreadedSource::freeBuffer(Slot& slot)
+{
+    for (std::size_t i = 0; i < slot.buffers.size(); ++i) {
+        const cv::Mat& b = slot.buffers[i];
+        if (b.u == nullptr || b.u->refcount == 1)
+            return static_cast<int>(i);
+    }
+    if (slot.buffers.size() < kBuffersPerSlot) {
+        slot.buffers.emplace_back();
+        return static_cast<int>(slot.buffers.size()) - 1;
+    }
+    return -1;
+}
+
+void ThreadedSource::captureLoop()
+{
+    for (;;) {
+        int idx;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            idx = acquireSlot(lock);
+            if (idx < 0)
+                return;
+        }
+
+        Slot& slot = m_slots[static_cast<std::size_t>(idx)];
+        // 消费方仍持有的缓冲区不被覆写：轮换到空闲的一块；全部被占用时临时分配，不入槽
+        slot.frame.release();
+        const int buf = freeBuffer(slot);
+        if (buf >= 0)
+            slot.frame = slot.buffers[static_cast<std::size_t>(buf)];
+
+        std::uint64_t gen;
+        bool          seekPending;
+        double        seekTarget;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            gen         = m_generation;
+            seekPending = m_seekPending;
+            seekTarget  = m_seekTarget;
+            m_seekPending = false;
+        }
+        // 跳转在采集线程执行，帧线程不等待解码；期间再次跳转会递增代数，本次读出的帧随之作废。
+        // 跳转失败时从当前位置继续读取
+        if (seekPending)
+            m_inner->seek(seekTarget);
+
+        const bool ok = m_inner->read(slot.frame) && !slot.frame.empty();
+        // 首次使用或分辨率变化时 read 新分配了像素，记回槽位供后续复用；
+        // 源交出的是其自有缓冲区（ScreenSource 的轮换缓冲）时不收留，以免其永远判定为被占用
+        if (ok && buf >= 0 && slot.frame.u && slot.frame.u->refcount == 1)
+            slot.buffers[static_cast<std::size_t>(buf)] = slot.frame;
+        slot.posMsec = ok ? m_inner->posMsec() : 0.0;
+        slot.dirty   = ok ? m_inner->dirtyRegions() : std::vector<cv::Rect>{};
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!ok || gen != m_generation) {
+                m_free.push_back(idx);
+                if (!ok && gen == m_generation)
+                    m_eof = true;
+            } else {
+                if (m_carryPending) {
+                    mergeDirty(slot.dirty, m_carry);
+                    m_carryPending = false;
+                }
+                m_ready.push_back(idx);
+                ++m_stats.captured;
+            }
+        }
+        m_readyCv.notify_one();
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "VideoSource.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 采集策略：实时源只保留最新帧（下游变慢时丢弃旧帧，延迟有上限）；
+// 文件源无损背压（槽位用尽时采集线程等待消费）
+enum class CapturePolicy { Auto, LatestOnly, Lossless };
+
+struct CaptureStats {
+    std::uint64_t captured = 0;   // 采集线程读到的帧
+    std::uint64_t dropped  = 0;   // 未被消费即被覆盖/丢弃的帧
+    std::uint64_t consumed = 0;   // read() 取走的帧
+};
+
+// 独立采集线程 + 预分配帧槽环：包装任意 VideoSource，read() 不再在调用线程阻塞于设备
+class ThreadedSource : public VideoSource {
+public:
+    // Auto：有时长（文件）取 Lossless，否则取 LatestOnly
+    // slots 为 0 时按策略取值：实时源 3 个槽位，文件源 8 个（即预解码深度）
+    explicit ThreadedSource(std::unique_ptr<VideoSource> inner,
+                            CapturePolicy policy = CapturePolicy::Auto, int slots = 0);
+    ~ThreadedSource() override;
+
+    bool open() override;
+    // 等待至多 timeoutMs 取一帧；超时或源已结束返回 false，二者由 finished() 区分
+    bool read(cv::Mat& frame) override;
+    void close() override;
+    bool isOpened() const override;
+
+    int    width()  const override        { return m_width; }
+    int    height() const override        { return m_height; }
+    double fps()    const override        { return m_fps; }
+    std::string description() const override { return m_description; }
+
+    void   pause()  override;
+    void   resume() override;
+    // 仅登记目标并丢弃已读出的帧后立即返回，定位本身（精确跳转可能需解码数秒视频）
+    // 由采集线程在下一次读取前执行；无时长的实时源返回 false
+    bool   seek(double posMsec) override;
+    double posMsec() const override;      // 最近一次取走的帧的位置
+    double durationMsec() const override  { return m_duration; }
+    // 最近一次取走的帧的变化区域；实时源丢帧时已并入被丢弃帧的区域
+    std::vector<cv::Rect> dirtyRegions() const override;
+
+    // 源已读完且环内无剩余帧
+    bool          finished() const;
+    CapturePolicy policy() const { return m_policy; }
+    CaptureStats  stats() const;
+    void          setReadTimeout(int ms) { m_readTimeoutMs = ms; }
+
+private:
+    struct Slot {
+        cv::Mat               frame;     // 当前帧，指向 buffers 中的一块
+        std::vector<cv::Mat>  buffers;   // 该槽位轮换使用的像素缓冲区
+        double                posMsec = 0.0;
+        std::vector<cv::Rect> dirty;
+    };
+
+    void captureLoop();
+    // 取槽位内未被下游持有的缓冲区（仅 buffers 自身引用），必要时新增；用尽返回 -1
+    static int  freeBuffer(Slot& slot);
+    int  acquireSlot(std::unique_lock<std::mutex>& lock);   // 无可用槽位（停止）返回 -1
+    void flushReady();                                       // 调用方持有 m_mutex
+    // 被丢弃帧 from 的变化区域并入其后的帧 into（任一为空即整帧变化）
+    static void mergeDirty(std::vector<cv::Rect>& into, const std::vector<cv::Rect>& from);
+
+    std::unique_ptr<VideoSource> m_inner;
+    CapturePolicy                m_policy;
+    int                          m_slotRequest;
+
+    // 打开时缓存的源属性（VideoCapture::get 与采集线程的 read 不可并发）
+    int         m_width    = 0;
+    int         m_height   = 0;
+    double      m_fps      = 0.0;
+    double      m_duration = 0.0;
+    std::string m_description;
+
+    std::vector<Slot> m_slots;
+    std::deque<int>   m_ready;       // 待消费槽位，按采集顺序
+    std::vector<int>  m_free;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_readyCv;
+    std::condition_variable m_freeCv;
+    std::uint64_t           m_generation = 0; // 跳转后递增，丢弃跳转前已读出的帧
+    bool                    m_seekPending = false;   // 采集线程待执行的跳转（m_inner 只由采集线程访问）
+    double                  m_seekTarget  = 0.0;
+    bool                    m_stop   = false;
+    bool                    m_paused = false;
+    bool                    m_eof    = false;
+    double                  m_pos    = 0.0;
+    std::vector<cv::Rect>   m_dirty;           // 最近取走的帧
+    std::vector<cv::Rect>   m_carry;           // 覆盖旧帧时待并入下一帧的区域
+    bool                    m_carryPending = false;
+    CaptureStats            m_stats;
+    std::atomic<int>        m_readTimeoutMs{100};
+    std::thread             m_thread;
+};
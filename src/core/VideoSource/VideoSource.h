@@ -1,6 +1,7 @@
 #pragma once
 #include <opencv2/core.hpp>
 #include <string>
+#include <vector>
 
 class VideoSource {
 public:
@@ -34,4 +35,11 @@ public:
     virtual bool seek(double /*posMsec*/) { return false; }   // 跳转（仅 FileSource）
     virtual double posMsec() const { return 0.0; }            // 当前位置（ms）
     virtual double durationMsec() const { return 0.0; }       // 总时长（ms）
+
+    // 最近一帧相对上一帧的变化区域；空 = 未知，视为整帧变化（仅 ScreenSource 提供）。
+    // 运动门控据此跳过帧差（MotionGate::evaluateRegions）
+    virtual std::vector<cv::Rect> dirtyRegions() const { return {}; }
+
+    // 唤醒阻塞在 read() 中的调用（由其它线程调用，之后 read() 返回 false）
+    virtual void interrupt() {}
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+// 检测引擎基准（命令行）：在同一组样本帧上依次测量各引擎的端到端 detect 耗时
+//   RVSFDT_bench <model.onnx> <图像或视频> [--engine dnn|ort|all] [--iterations N]
+//                [--warmup N] [--frames N] [--labels labels.txt]
+#include "Detection/DetectorBenchmark.h"
+#include "Detection/DetectorEngine.h"
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/videoio.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage()
+{
+    std::fprintf(stderr,
+        "用法: RVSFDT_bench <model.onnx> <图像或视频> [--engine dnn|ort|all]\n"
+        "                   [--iterations N] [--warmup N] [--frames N] [--labels labels.txt]\n");
+}
+
+// 图像读为单帧样本；否则按视频读取前 maxFrames 帧
+std::vector<cv::Mat> loadSamples(const std::string& path, int maxFrames)
+{
+    std::vector<cv::Mat> samples;
+    cv::Mat img = cv::imread(path, cv::IMREAD_COLOR);
+    if (!img.empty()) {
+        samples.push_back(img);
+        return samples;
+    }
+
+    cv::VideoCapture cap;
+    if (!cap.open(path))
+        return samples;
+    cv::Mat frame;
+    while (static_cast<int>(samples.size()) < maxFrames && cap.read(frame) && !frame.empty())
+        samples.push_back(frame.clone());
+    return samples;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+
+    const std::string modelPath  = argv[1];
+    const std::string samplePath = argv[2];
+    std::string engineArg = "all";
+    std::string labelsPath;
+    int iterations = 50;
+    int warmup     = 5;
+    int maxFrames  = 16;
+
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (arg == "--engine")          engineArg  = value;
+        else if (arg == "--iterations") iterations = std::atoi(value);
+        else if (arg == "--warmup")     warmup     = std::atoi(value);
+        else if (arg == "--frames")     maxFrames  = std::atoi(value);
+        else if (arg == "--labels")     labelsPath = value;
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<DetectorEngine> engines;
+    if (engineArg == "all") {
+        for (DetectorEngine e : { DetectorEngine::OpenCvDnn, DetectorEngine::OnnxRuntime })
+            if (DetectorEngines::available(e))
+                engines.push_back(e);
+    } else {
+        DetectorEngine e;
+        if (!DetectorEngines::parse(engineArg, e)) {
+            usage();
+            return 2;
+        }
+        if (!DetectorEngines::available(e)) {
+            std::fprintf(stderr, "引擎 %s 未包含在当前构建中\n", engineArg.c_str());
+            return 1;
+        }
+        engines.push_back(e);
+    }
+
+    const std::vector<cv::Mat> samples = loadSamples(samplePath, std::max(1, maxFrames));
+    if (samples.empty()) {
+        std::fprintf(stderr, "无法读取样本：%s\n", samplePath.c_str());
+        return 1;
+    }
+    std::printf("样本 %zu 帧（%dx%d），%d 次计时 / %d 次预热\n", samples.size(),
+                samples.front().cols, samples.front().rows, iterations, warmup);
+
+    int failed = 0;
+    for (DetectorEngine e : engines) {
+        const std::string name = DetectorEngines::name(e);
+        auto detector = DetectorEngines::create(e);
+        if (!detector || !detector->loadModel(modelPath, labelsPath)) {
+            std::fprintf(stderr, "%s: 模型加载失败：%s\n", name.c_str(), modelPath.c_str());
+            ++failed;
+            continue;
+        }
+        const DetectorBenchmark::Result r =
+            DetectorBenchmark::run(*detector, samples, iterations, warmup);
+        std::printf("%s\n", DetectorBenchmark::format(name, r).c_str());
+    }
+    return failed == 0 ? 0 : 1;
+}
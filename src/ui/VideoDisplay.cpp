@@ -0,0 +1,153 @@
+#include "VideoDisplay.h"
+#include <QPainter>
+#include <QPaintEvent>
+
+namespace {
+
+void releaseMat(void* info)
+{
+    delete static_cast<cv::Mat*>(info);
+}
+
+} // namespace
+
+VideoDisplay::VideoDisplay(QWidget* parent)
+    : QWidget(parent)
+{
+    // 每次重绘整块覆盖，无需 Qt 先擦除背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void VideoDisplay::setController(VideoController* controller)
+{
+    if (m_controller)
+        disconnect(m_controller, nullptr, this, nullptr);
+    if (m_leader) {
+        disconnect(m_leader, nullptr, this, nullptr);
+        m_leader = nullptr;
+    }
+    m_controller = controller;
+    if (m_controller)
+        connect(m_controller, &VideoController::displayFrameAvailable,
+                this, &VideoDisplay::onFrameAvailable, Qt::QueuedConnection);
+}
+
+void VideoDisplay::follow(VideoDisplay* leader)
+{
+    setController(nullptr);
+    m_leader = leader;
+    if (m_leader)
+        connect(m_leader, &VideoDisplay::frameShown, this, &VideoDisplay::onLeaderFrame);
+}
+
+void VideoDisplay::setChannel(Channel channel)
+{
+    m_channel = channel;
+    rewrap();
+    update();
+}
+
+void VideoDisplay::setShowDetections(bool show)
+{
+    m_showDetections = show;
+    update();
+}
+
+QImage VideoDisplay::wrap(const cv::Mat& frame)
+{
+    if (frame.empty() || frame.depth() != CV_8U)
+        return {};
+
+    QImage::Format fmt;
+    switch (frame.channels()) {
+    case 1: fmt = QImage::Format_Grayscale8; break;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    case 3: fmt = QImage::Format_BGR888;     break;
+#else
+    case 3: {
+        // 旧版 Qt 无 BGR888，只能交换通道（拷贝）
+        const QImage rgb(frame.data, frame.cols, frame.rows,
+                         static_cast<int>(frame.step), QImage::Format_RGB888);
+        return rgb.rgbSwapped();
+    }
+#endif
+    case 4: fmt = QImage::Format_ARGB32;     break;   // 小端内存序 B,G,R,A
+    default: return {};
+    }
+
+    // 由 QImage 的清理回调持有一份 cv::Mat 引用，保证缓冲区在显示期间有效
+    auto* keep = new cv::Mat(frame);
+    return QImage(keep->data, keep->cols, keep->rows, static_cast<int>(keep->step),
+                  fmt, &releaseMat, keep);
+}
+
+void VideoDisplay::onFrameAvailable()
+{
+    if (!m_controller)
+        return;
+
+    const std::uint64_t previous = m_frame.frameId;
+    if (!m_controller->takeDisplayFrame(m_frame))
+        return;
+    showFrame(previous);
+    emit frameShown();
+}
+
+void VideoDisplay::onLeaderFrame()
+{
+    if (!m_leader)
+        return;
+    const std::uint64_t previous = m_frame.frameId;
+    m_frame = m_leader->currentFrame();
+    showFrame(previous);
+}
+
+void VideoDisplay::showFrame(std::uint64_t previousId)
+{
+    if (previousId > 0 && m_frame.frameId > previousId + 1)
+        m_skipped += m_frame.frameId - previousId - 1;
+    ++m_shown;
+
+    rewrap();
+    update();   // 多次 update 合并为一次重绘，只绘制最新帧
+}
+
+void VideoDisplay::rewrap()
+{
+    m_image = wrap(m_channel == Channel::Original ? m_frame.original : m_frame.processed);
+}
+
+void VideoDisplay::paintEvent(QPaintEvent* /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+    if (m_image.isNull())
+        return;
+
+    // 等比缩放居中，绘制时由 QPainter 完成缩放，不生成中间 QPixmap
+    QSize target = m_image.size();
+    target.scale(size(), Qt::KeepAspectRatio);
+    const QRect dst(QPoint((width() - target.width()) / 2, (height() - target.height()) / 2), target);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, target.width() < m_image.width());
+    painter.drawImage(dst, m_image);
+
+    if (!m_showDetections || m_frame.detections.empty())
+        return;
+
+    // 检测框坐标为代理分辨率（与显示帧一致），按显示缩放映射
+    const double sx = static_cast<double>(dst.width())  / m_image.width();
+    const double sy = static_cast<double>(dst.height()) / m_image.height();
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    for (const Detection& d : m_frame.detections) {
+        const QRectF box(dst.x() + d.bbox.x * sx, dst.y() + d.bbox.y * sy,
+                         d.bbox.width * sx, d.bbox.height * sy);
+        painter.setPen(QPen(Qt::green, 2));
+        painter.drawRect(box);
+
+        QString text = QString::fromStdString(d.label)
+                     + QStringLiteral(" %1").arg(d.confidence, 0, 'f', 2);
+        if (d.trackId >= 0)
+            text += QStringLiteral(" #%1").arg(d.trackId);
+        painter.drawText(box.topLeft() + QPointF(2, -4), text);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <QImage>
+#include <QPointer>
+#include <QWidget>
+#include "core/VideoController.h"
+
+// 视频显示控件：从 VideoController 的显示邮箱取最新帧，
+// 以共享池化缓冲区的 QImage 直接绘制（无 cv::Mat → QImage/QPixmap 拷贝）
+class VideoDisplay : public QWidget {
+    Q_OBJECT
+
+public:
+    enum class Channel { Original, Processed };
+
+    explicit VideoDisplay(QWidget* parent = nullptr);
+
+    // 连接控制器的 displayFrameAvailable。显示邮箱只有一个消费者：每个控制器只能由一个控件取帧，
+    // 显示同一路视频的其它控件（如另一通道）用 follow() 跟随该控件
+    void setController(VideoController* controller);
+    // 跟随 leader：每当 leader 取到新帧即共享同一帧（像素为引用，不拷贝），与 setController 互斥
+    void follow(VideoDisplay* leader);
+    void setChannel(Channel channel);
+    void setShowDetections(bool show);
+
+    // 包装 8UC1 / 8UC3(BGR) / 8UC4(BGRA) 帧为 QImage，不拷贝像素；
+    // QImage（及其浅拷贝）存活期间持有 frame 的引用，缓冲区不会被池复用
+    static QImage wrap(const cv::Mat& frame);
+
+    // 已显示帧数与被邮箱覆盖（未显示）的帧数可由 frameId 间隔推算
+    std::uint64_t shownFrames()   const { return m_shown; }
+    std::uint64_t skippedFrames() const { return m_skipped; }
+
+    const DisplayFrame& currentFrame() const { return m_frame; }
+
+signals:
+    void frameShown();   // 取到新帧并已安排重绘（跟随者据此更新）
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private slots:
+    void onFrameAvailable();
+    void onLeaderFrame();
+
+private:
+    void rewrap();
+    void showFrame(std::uint64_t previousId);   // m_frame 已更新：统计、包装并重绘
+
+    VideoController*      m_controller = nullptr;
+    QPointer<VideoDisplay> m_leader;
+    Channel          m_channel    = Channel::Processed;
+    bool             m_showDetections = true;
+
+    DisplayFrame     m_frame;   // 当前显示帧（持有池化缓冲区引用）
+    QImage           m_image;   // 包装 m_frame 的对应通道
+    std::uint64_t    m_shown   = 0;
+    std::uint64_t    m_skipped = 0;
+};
@@ -1,5 +1,7 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "VideoDisplay.h"
+#include "core/VideoController.h"
 
 #include <QFileDialog>
 #include <QMessageBox>
@@ -11,6 +13,7 @@ MainWindow::MainWindow(QWidget *parent)
 {
     ui->setupUi(this);
     setupStatusBar();
+    setupController();
     updateAllParamLabels();
 
     // 参数面板默认禁用（随对应 checkbox 联动）
@@ -25,9 +28,37 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
+    ui->vd_processedVideo->setController(nullptr);
+    delete m_controller;   // 在工作线程内关闭输入源后结束该线程
     delete ui;
 }
 
+void MainWindow::setupController()
+{
+    m_controller = new VideoController;
+    m_controller->moveToWorkerThread();
+
+    // 显示邮箱只有一个消费者：处理后视频取帧，原始视频跟随同一帧显示另一通道
+    ui->vd_processedVideo->setChannel(VideoDisplay::Channel::Processed);
+    ui->vd_processedVideo->setController(m_controller);
+    ui->vd_originalVideo->setChannel(VideoDisplay::Channel::Original);
+    ui->vd_originalVideo->setShowDetections(false);
+    ui->vd_originalVideo->follow(ui->vd_processedVideo);
+
+    connect(m_controller, &VideoController::fpsUpdated, this, [this](double fps) {
+        m_lblFps->setText(QStringLiteral("FPS: %1").arg(fps, 0, 'f', 1));
+    });
+    connect(m_controller, &VideoController::resolutionChanged, this, [this](int w, int h) {
+        m_lblResolution->setText(QStringLiteral("分辨率: %1×%2").arg(w).arg(h));
+    });
+    connect(m_controller, &VideoController::sourceError, this, [this](const QString& message) {
+        statusBar()->showMessage(message, 5000);
+    });
+    connect(m_controller, &VideoController::screenshotSaved, this, [this](const QString& path) {
+        statusBar()->showMessage(QStringLiteral("截图已保存: ") + path, 3000);
+    });
+}
+
 void MainWindow::setupStatusBar()
 {
     m_lblFps        = new QLabel(QStringLiteral("FPS: --"), this);
@@ -84,8 +115,14 @@ void MainWindow::on_actionOpenFile_triggered()
         QStringLiteral("打开视频文件"),
         {},
         QStringLiteral("视频文件 (*.mp4 *.avi *.mkv *.mov);;所有文件 (*.*)"));
-    if (!path.isEmpty())
-        statusBar()->showMessage(QStringLiteral("已打开: ") + path, 3000);
+    if (path.isEmpty())
+        return;
+    QMetaObject::invokeMethod(m_controller, [this, path] { m_controller->onOpenFile(path); });
+    // 打开后立即开始播放
+    m_isPlaying = true;
+    ui->actionPlayPause->setChecked(true);
+    ui->actionPlayPause->setText(QStringLiteral("暂停"));
+    statusBar()->showMessage(QStringLiteral("已打开: ") + path, 3000);
 }
 
 void MainWindow::on_actionOpenScreen_triggered()
@@ -96,6 +133,7 @@ void MainWindow::on_actionOpenScreen_triggered()
 void MainWindow::on_actionPlayPause_triggered()
 {
     m_isPlaying = ui->actionPlayPause->isChecked();
+    QMetaObject::invokeMethod(m_controller, [this] { m_controller->onPlayPause(); });
     ui->actionPlayPause->setText(m_isPlaying ? QStringLiteral("暂停") : QStringLiteral("播放"));
     statusBar()->showMessage(m_isPlaying ? QStringLiteral("播放中…") : QStringLiteral("已暂停"), 1500);
 }
@@ -103,6 +141,7 @@ void MainWindow::on_actionPlayPause_triggered()
 void MainWindow::on_actionStop_triggered()
 {
     m_isPlaying = false;
+    QMetaObject::invokeMethod(m_controller, [this] { m_controller->onStop(); });
     ui->actionPlayPause->setChecked(false);
     ui->actionPlayPause->setText(QStringLiteral("播放"));
     statusBar()->showMessage(QStringLiteral("已停止"), 1500);
@@ -110,8 +149,8 @@ void MainWindow::on_actionStop_triggered()
 
 void MainWindow::on_actionScreenshot_triggered()
 {
-    // TODO: 将 lbl_processedVideo 的当前帧保存为图片
-    statusBar()->showMessage(QStringLiteral("截图已保存"), 2000);
+    // 控制器在工作线程保存当前帧，保存成功后经 screenshotSaved 提示；尚无帧时不保存
+    QMetaObject::invokeMethod(m_controller, [this] { m_controller->onScreenshot(); });
 }
 
 void MainWindow::on_actionRecord_triggered()
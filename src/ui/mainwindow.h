@@ -10,6 +10,8 @@ class MainWindow;
 }
 QT_END_NAMESPACE
 
+class VideoController;
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -57,10 +59,14 @@ private slots:
 
 private:
     void setupStatusBar();
+    void setupController();
     void updateAllParamLabels();
 
     Ui::MainWindow *ui;
 
+    // 帧循环在控制器自己的线程运行，所有指令经排队调用送达
+    VideoController *m_controller = nullptr;
+
     // 状态栏永久标签
     QLabel *m_lblFps       = nullptr;
     QLabel *m_lblResolution = nullptr;
@@ -0,0 +1,178 @@
+// 融合内核与通用 FilterChain 路径的逐位一致性
+// 覆盖灰度/BGR 输入、奇数尺寸，以及行数恰好落在带边界（band 的整数倍 ±1）的帧
+#include "TestCheck.h"
+#include "Filter/FilterChain.h"
+#include "Filter/FusedKernels.h"
+#include "Filter/GrayscaleFilter.h"
+#include "Filter/GaussianFilter.h"
+#include "Filter/CannyFilter.h"
+#include "Filter/ThresholdFilter.h"
+#include <opencv2/core.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using FilterList = std::vector<std::shared_ptr<FilterBase>>;
+
+// 与 FusedKernels.cpp 的带高规则一致
+int bandRows(int kernelSize)
+{
+    return std::max(32, 4 * (kernelSize / 2));
+}
+
+std::vector<int> rowsAroundBands(int kernelSize)
+{
+    const int band = bandRows(kernelSize);
+    return { band - 1, band, band + 1, 2 * band + 1, 3 * band - 1, 5 * band + 7 };
+}
+
+cv::Mat randomFrame(cv::RNG& rng, int rows, int cols, int type)
+{
+    cv::Mat m(rows, cols, type);
+    rng.fill(m, cv::RNG::UNIFORM, 0, 256);
+    return m;
+}
+
+std::string describe(const char* kind, const cv::Mat& src, int k)
+{
+    return std::string(kind) + " " + std::to_string(src.cols) + "x" + std::to_string(src.rows)
+         + " ch=" + std::to_string(src.channels()) + " k=" + std::to_string(k);
+}
+
+// 通用路径：关闭融合的 FilterChain，逐级执行
+cv::Mat runGeneric(const FilterList& filters, const cv::Mat& src)
+{
+    FilterChain chain;
+    chain.setFusionEnabled(false);
+    for (const auto& f : filters)
+        chain.append(f);
+    return chain.processNative(src).clone();
+}
+
+// 融合路径：直接匹配并执行融合内核
+cv::Mat runFused(const FilterList& filters, const cv::Mat& src, FusedKernels::Kind expected,
+                 const std::string& ctx)
+{
+    std::vector<FilterBase*> raw;
+    for (const auto& f : filters)
+        raw.push_back(f.get());
+
+    const FusedKernels::Plan plan = FusedKernels::match(raw.data(), raw.size(), FrameFormat::of(src));
+    CHECK(plan.kind == expected, ctx);
+    CHECK(plan.length == raw.size(), ctx);
+
+    cv::Mat dst;
+    FusedKernels::run(plan, src, dst);
+    return dst;
+}
+
+void expectIdentical(const cv::Mat& fused, const cv::Mat& generic, const std::string& ctx)
+{
+    CHECK(fused.size() == generic.size(), ctx);
+    CHECK(fused.type() == generic.type(), ctx);
+    if (fused.size() == generic.size() && fused.type() == generic.type())
+        CHECK(cv::norm(fused, generic, cv::NORM_INF) == 0.0, ctx);
+}
+
+GaussianParams exactGauss(int k)
+{
+    GaussianParams p;
+    p.kernelSize = k;
+    p.sigmaX     = 0.3 * ((k - 1) * 0.5 - 1) + 0.8;
+    p.engine     = BlurEngine::Exact;   // 盒式引擎不参与融合
+    return p;
+}
+
+void testGrayBlurThreshold(cv::RNG& rng)
+{
+    ThresholdParams tp;
+    tp.type  = ThresholdType::Fixed;
+    tp.value = 117.0;
+
+    for (int k : { 3, 5, 9, 21 }) {
+        for (int rows : rowsAroundBands(k)) {
+            for (int cols : { 17, 101 }) {
+                for (int type : { CV_8UC1, CV_8UC3 }) {
+                    const cv::Mat src = randomFrame(rng, rows, cols, type);
+                    const std::string ctx = describe("GrayBlurThreshold", src, k);
+
+                    const FilterList filters = {
+                        std::make_shared<GrayscaleFilter>(),
+                        std::make_shared<GaussianFilter>(exactGauss(k)),
+                        std::make_shared<ThresholdFilter>(tp),
+                    };
+                    expectIdentical(runFused(filters, src, FusedKernels::Kind::GrayBlurThreshold, ctx),
+                                    runGeneric(filters, src), ctx);
+                }
+            }
+        }
+    }
+}
+
+void testBlurCanny(cv::RNG& rng)
+{
+    CannyParams cp;
+    cp.threshold1 = 40.0;
+    cp.threshold2 = 120.0;
+
+    for (int k : { 3, 7, 21 }) {
+        for (int rows : rowsAroundBands(k)) {
+            for (int cols : { 33, 99 }) {
+                const cv::Mat src = randomFrame(rng, rows, cols, CV_8UC3);
+                const std::string ctx = describe("BlurCanny", src, k);
+
+                const FilterList filters = {
+                    std::make_shared<GaussianFilter>(exactGauss(k)),
+                    std::make_shared<CannyFilter>(cp),
+                };
+                expectIdentical(runFused(filters, src, FusedKernels::Kind::BlurCanny, ctx),
+                                runGeneric(filters, src), ctx);
+            }
+        }
+    }
+}
+
+// 灰度输入的 高斯 → Canny 不属于融合序列，链应回退为逐级执行
+void testBlurCannyGrayNotFused(cv::RNG& rng)
+{
+    const cv::Mat src = randomFrame(rng, 65, 47, CV_8UC1);
+    GaussianFilter blur(exactGauss(5));
+    CannyFilter    canny;
+    FilterBase* raw[] = { &blur, &canny };
+    const FusedKernels::Plan plan = FusedKernels::match(raw, 2, FrameFormat::of(src));
+    CHECK(plan.kind == FusedKernels::Kind::None, describe("BlurCanny(gray)", src, 5));
+}
+
+// 启用融合的链与关闭融合的链结果一致（融合在链内的接入路径）
+void testChainWithFusion(cv::RNG& rng)
+{
+    ThresholdParams tp;
+    tp.value = 90.0;
+    const cv::Mat src = randomFrame(rng, 129, 77, CV_8UC3);
+    const std::string ctx = describe("FilterChain fused vs generic", src, 5);
+
+    const FilterList filters = {
+        std::make_shared<GrayscaleFilter>(),
+        std::make_shared<GaussianFilter>(exactGauss(5)),
+        std::make_shared<ThresholdFilter>(tp),
+    };
+    FilterChain fused;
+    for (const auto& f : filters)
+        fused.append(f);
+    expectIdentical(fused.processNative(src).clone(), runGeneric(filters, src), ctx);
+}
+
+} // namespace
+
+int main()
+{
+    cv::RNG rng(0x5eed);
+    testGrayBlurThreshold(rng);
+    testBlurCanny(rng);
+    testBlurCannyGrayNotFused(rng);
+    testChainWithFusion(rng);
+    return test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// 盒式（StackedBox）引擎相对精确高斯核的误差上界
+// Auto 规则在核尺寸 ≥ boxThreshold 时改用盒式引擎，这里校验该范围内画质损失可接受
+#include "TestCheck.h"
+#include "Filter/GaussianFilter.h"
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <string>
+
+namespace {
+
+constexpr double kMinPsnr       = 35.0;   // dB
+constexpr double kMaxAbsDiff    = 16.0;   // 8U 像素值，出现在高对比度阶跃边缘
+constexpr double kIdenticalPsnr = 361.0;  // cv::PSNR 对完全一致输入的约定值
+
+// 合成场景：平滑渐变 + 高对比度色块 + 轻微噪声（阶跃边缘是两种引擎差异最大处）
+cv::Mat syntheticScene(cv::RNG& rng, cv::Size size, int type)
+{
+    cv::Mat img(size, type);
+    const int ch = img.channels();
+    for (int y = 0; y < size.height; ++y) {
+        uchar* row = img.ptr<uchar>(y);
+        for (int x = 0; x < size.width; ++x)
+            for (int c = 0; c < ch; ++c)
+                row[x * ch + c] = cv::saturate_cast<uchar>(
+                    40 + 160.0 * (x + (c + 1) * y) / (size.width + (c + 1) * size.height));
+    }
+
+    for (int i = 0; i < 24; ++i) {
+        const cv::Point p0(rng.uniform(0, size.width), rng.uniform(0, size.height));
+        const cv::Point p1(rng.uniform(0, size.width), rng.uniform(0, size.height));
+        const cv::Scalar color(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+        if (i % 2 == 0)
+            cv::rectangle(img, p0, p1, color, cv::FILLED);
+        else
+            cv::circle(img, p0, rng.uniform(4, 40), color, cv::FILLED);
+    }
+
+    cv::Mat noise(size, CV_MAKETYPE(CV_16S, ch));
+    rng.fill(noise, cv::RNG::NORMAL, 0, 3);
+    cv::add(img, noise, img, cv::noArray(), img.type());
+    return img;
+}
+
+std::string describe(const cv::Mat& src, const GaussianParams& p, const BlurAccuracy& acc)
+{
+    return std::to_string(src.cols) + "x" + std::to_string(src.rows)
+         + " ch=" + std::to_string(src.channels())
+         + " k=" + std::to_string(p.kernelSize) + " sigma=" + std::to_string(p.sigmaX)
+         + " psnr=" + std::to_string(acc.psnr) + " maxAbs=" + std::to_string(acc.maxAbsDiff);
+}
+
+// Auto 规则切换到盒式引擎的核尺寸范围（sigma 由核尺寸推导，或由用户指定）
+void testBoxEngineBounds(cv::RNG& rng)
+{
+    struct Case { int k; double sigma; };
+    const Case cases[] = {
+        { 15, 0.0 }, { 21, 0.0 }, { 31, 0.0 },
+        { 15, 2.0 }, { 25, 4.0 }, { 31, 5.0 },
+    };
+
+    for (int type : { CV_8UC1, CV_8UC3 }) {
+        const cv::Mat src = syntheticScene(rng, cv::Size(321, 243), type);
+        for (const Case& c : cases) {
+            GaussianParams p;
+            p.kernelSize = c.k;
+            p.sigmaX     = c.sigma;
+            p.engine     = BlurEngine::Auto;
+            CHECK(GaussianFilter::usesBoxEngine(p), "Auto 应在 k >= boxThreshold 时选择盒式引擎");
+
+            const BlurAccuracy acc = GaussianFilter::compareEngines(src, p);
+            const std::string ctx = describe(src, p, acc);
+            CHECK(acc.psnr >= kMinPsnr, ctx);
+            CHECK(acc.maxAbsDiff <= kMaxAbsDiff, ctx);
+        }
+    }
+}
+
+// 核尺寸 1 时两种引擎都退化为恒等变换
+void testIdentityKernel(cv::RNG& rng)
+{
+    const cv::Mat src = syntheticScene(rng, cv::Size(97, 61), CV_8UC3);
+    GaussianParams p;
+    p.kernelSize = 1;
+    p.sigmaX     = 0.0;
+
+    const BlurAccuracy acc = GaussianFilter::compareEngines(src, p);
+    const std::string ctx = describe(src, p, acc);
+    CHECK(acc.maxAbsDiff == 0.0, ctx);
+    CHECK(acc.psnr == kIdenticalPsnr, ctx);
+}
+
+} // namespace
+
+int main()
+{
+    cv::RNG rng(0xb10b);
+    testBoxEngineBounds(rng);
+    testIdentityKernel(rng);
+    return test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// PipelineScheduler 的滤镜降级与检测推迟决策
+#include "TestCheck.h"
+#include "PipelineScheduler.h"
+#include <string>
+
+namespace {
+
+// EMA 收敛到 msec：连续记录足够多次
+void settle(PipelineScheduler& s, PipelineStage stage, double msec)
+{
+    for (int i = 0; i < 200; ++i)
+        s.record(stage, msec);
+}
+
+void testDegradeAndHold()
+{
+    PipelineScheduler s;
+    s.reset(30.0);
+
+    // 轻负载：不降级，检测照常提交
+    settle(s, PipelineStage::Filter, 1.0);
+    FramePlan plan = s.beginFrame(-1.0);
+    CHECK(!plan.degradeFilters, "轻负载不应降级");
+    CHECK(plan.runDetect, "推理线程空闲时应提交检测");
+
+    // 滤镜耗时远超帧间隔：降级
+    s.reset(30.0);
+    settle(s, PipelineStage::Filter, 100.0);
+    plan = s.beginFrame(-1.0);
+    CHECK(plan.degradeFilters, "超出预算应降级滤镜");
+    CHECK(plan.runDetect, "帧预算不足不应舍弃检测提交");
+
+    // 负载恢复后仍保持降级 kDegradeHoldFrames 帧，之后恢复
+    settle(s, PipelineStage::Filter, 0.0);
+    for (int i = 0; i < PipelineScheduler::kDegradeHoldFrames; ++i) {
+        plan = s.beginFrame(-1.0);
+        CHECK(plan.degradeFilters, "降级保持期第 " + std::to_string(i) + " 帧");
+    }
+    plan = s.beginFrame(-1.0);
+    CHECK(!plan.degradeFilters, "保持期结束应恢复");
+}
+
+void testDetectDeferral()
+{
+    PipelineScheduler s;
+    s.reset(30.0);
+
+    // 推理线程持续繁忙：连续推迟不超过上限，之后强制提交
+    int deferred = 0;
+    for (int i = 0; i < PipelineScheduler::kMaxDetectDeferrals; ++i) {
+        const FramePlan plan = s.beginFrame(-1.0, true);
+        CHECK(!plan.runDetect, "繁忙第 " + std::to_string(i) + " 帧应推迟");
+        if (!plan.runDetect) {
+            s.skip(PipelineStage::Detect);
+            ++deferred;
+        }
+    }
+    FramePlan plan = s.beginFrame(-1.0, true);
+    CHECK(plan.runDetect, "连续推迟 " + std::to_string(deferred) + " 次后应强制提交");
+    s.detectSubmitted();
+
+    // 提交后计数清零，繁忙时重新开始推迟
+    plan = s.beginFrame(-1.0, true);
+    CHECK(!plan.runDetect, "强制提交后应重新计数");
+    s.skip(PipelineStage::Detect);
+
+    // 推理线程空闲：立即提交
+    plan = s.beginFrame(-1.0, false);
+    CHECK(plan.runDetect, "空闲时应提交");
+    s.detectSubmitted();
+
+    const PipelineTimings t = s.timings();
+    CHECK(t.stages[static_cast<std::size_t>(PipelineStage::Detect)].skipped
+              == static_cast<std::uint64_t>(deferred + 1),
+          "推迟次数应计入统计");
+}
+
+} // namespace
+
+int main()
+{
+    testDegradeAndHold();
+    testDetectDeferral();
+    return test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// ScreenSource 在 Xvfb 虚拟显示上的端到端校验（由 xvfb-run 启动，见 CMakeLists.txt）
+// 覆盖：XDamage 变化区域、按外接区域读取后的像素正确性、下游持有帧时的缓冲区轮换与积压区域补齐
+#include "TestCheck.h"
+#include "VideoSource/ScreenSource.h"
+#include <opencv2/core.hpp>
+#include <string>
+#include <vector>
+
+// X11 头文件定义了 Bool/Status/None 等宏，须在其它头文件之后包含
+#include <X11/Xlib.h>
+
+namespace {
+
+struct Painter {
+    Display* display = nullptr;
+    Window   root    = 0;
+    GC       gc      = nullptr;
+
+    bool open()
+    {
+        display = XOpenDisplay(nullptr);
+        if (!display)
+            return false;
+        root = DefaultRootWindow(display);
+        gc   = DefaultGC(display, DefaultScreen(display));
+        return true;
+    }
+
+    ~Painter()
+    {
+        if (display)
+            XCloseDisplay(display);
+    }
+
+    // 24 位 TrueColor：像素值即 0xRRGGBB
+    void fill(const cv::Rect& r, const cv::Vec3b& bgr)
+    {
+        const unsigned long pixel = (static_cast<unsigned long>(bgr[2]) << 16)
+                                  | (static_cast<unsigned long>(bgr[1]) << 8) | bgr[0];
+        XSetForeground(display, gc, pixel);
+        XFillRectangle(display, root, gc, r.x, r.y,
+                       static_cast<unsigned>(r.width), static_cast<unsigned>(r.height));
+        XSync(display, False);
+    }
+};
+
+std::string describe(const char* what, const cv::Rect& r)
+{
+    return std::string(what) + " rect=(" + std::to_string(r.x) + "," + std::to_string(r.y) + " "
+         + std::to_string(r.width) + "x" + std::to_string(r.height) + ")";
+}
+
+// 帧内 r 覆盖的像素全部为 bgr
+bool filled(const cv::Mat& frame, const cv::Rect& r, const cv::Vec3b& bgr)
+{
+    const cv::Mat roi = frame(r);
+    for (int y = 0; y < roi.rows; ++y)
+        for (int x = 0; x < roi.cols; ++x)
+            if (roi.at<cv::Vec3b>(y, x) != bgr)
+                return false;
+    return true;
+}
+
+bool covers(const std::vector<cv::Rect>& dirty, const cv::Rect& r)
+{
+    cv::Rect box;
+    for (const cv::Rect& d : dirty)
+        box = box.empty() ? d : (box | d);
+    return (box & r) == r;
+}
+
+} // namespace
+
+int main()
+{
+    Painter painter;
+    if (!painter.open()) {
+        std::fprintf(stderr, "无法连接 DISPLAY（应由 xvfb-run 启动）\n");
+        return 1;
+    }
+
+    ScreenSource source(cv::Rect(), 1000.0);   // 高帧率：测试不受限速影响
+    CHECK(source.open(), "open");
+    if (!source.isOpened())
+        return 1;
+
+    const cv::Rect r1(40, 30, 120, 80);
+    const cv::Rect r2(300, 200, 64, 48);
+    const cv::Rect r3(500, 60, 40, 300);
+    const cv::Vec3b c1(0x40, 0x80, 0xff);
+    const cv::Vec3b c2(0x10, 0xe0, 0x30);
+    const cv::Vec3b c3(0xc0, 0x20, 0x90);
+
+    // 首帧：整帧，变化区域为空
+    cv::Mat a;
+    CHECK(source.read(a), "首帧");
+    CHECK(a.cols == source.width() && a.rows == source.height() && a.type() == CV_8UC3, "首帧尺寸");
+    CHECK(source.dirtyRegions().empty(), "首帧应视为整帧变化");
+    const cv::Mat before = a.clone();
+
+    // 局部变化：只报告并更新该区域，区域外像素不变
+    painter.fill(r1, c1);
+    CHECK(source.read(a), "r1");
+    CHECK(!source.dirtyRegions().empty() && covers(source.dirtyRegions(), r1), describe("r1 dirty", r1));
+    CHECK(filled(a, r1, c1), describe("r1 像素", r1));
+    CHECK(cv::norm(a(r2), before(r2), cv::NORM_INF) == 0.0, describe("r1 区域外", r2));
+
+    // 下游持有上一帧：新帧写入另一块缓冲区，被持有的帧不被改写
+    cv::Mat held = a;
+    painter.fill(r2, c2);
+    cv::Mat b;
+    CHECK(source.read(b), "r2");
+    CHECK(b.data != held.data, "持有帧的缓冲区不应被复用");
+    CHECK(filled(b, r1, c1) && filled(b, r2, c2), describe("r2 像素", r2));
+    CHECK(cv::norm(held(r2), before(r2), cv::NORM_INF) == 0.0, describe("持有帧被改写", r2));
+
+    // 仍持有 b、释放首块缓冲区：下一帧复用首块，须补齐其错过的 r2 以及本次的 r3
+    const uchar* reused = held.data;
+    a.release();
+    held.release();
+    painter.fill(r3, c3);
+    cv::Mat c;
+    CHECK(source.read(c), "r3");
+    CHECK(c.data == reused, "空闲缓冲区应被复用");
+    CHECK(filled(c, r1, c1) && filled(c, r2, c2) && filled(c, r3, c3), describe("r3 像素", r3));
+    CHECK(!filled(b, r3, c3), describe("持有帧被改写", r3));
+
+    source.close();
+    return test::failures() == 0 ? 0 : 1;
+}
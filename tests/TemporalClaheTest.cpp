@@ -0,0 +1,99 @@
+// TemporalClahe 全量重算帧与 cv::createCLAHE()->apply 在 Y 通道上的逐位一致性
+// 覆盖：可整除 / 不可整除（含单方向可整除）的尺寸、不裁剪（clipLimit = 0）、按 refreshInterval 的周期重算
+#include "TestCheck.h"
+#include "Filter/TemporalClahe.h"
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// 低频亮度起伏叠加噪声：各 tile 直方图差异明显，裁剪与插值都会生效
+cv::Mat randomFrame(cv::RNG& rng, int rows, int cols)
+{
+    cv::Mat base(rows, cols, CV_8UC3);
+    rng.fill(base, cv::RNG::UNIFORM, 0, 256);
+    cv::Mat blurred;
+    cv::GaussianBlur(base, blurred, cv::Size(0, 0), std::max(rows, cols) / 16.0);
+    cv::Mat noise(base.size(), CV_MAKETYPE(CV_16S, 3));
+    rng.fill(noise, cv::RNG::NORMAL, 0, 20);
+    cv::add(blurred, noise, blurred, cv::noArray(), blurred.type());
+    return blurred;
+}
+
+std::string describe(const char* what, const cv::Mat& img, const TemporalClahe::Config& cfg)
+{
+    return std::string(what) + " " + std::to_string(img.cols) + "x" + std::to_string(img.rows)
+         + " tiles=" + std::to_string(cfg.tilesX) + "x" + std::to_string(cfg.tilesY)
+         + " clip=" + std::to_string(cfg.clipLimit);
+}
+
+// 对 frame 的 Y 通道应用 TemporalClahe，与 cv::CLAHE 逐位比较；其余通道不得改动
+void expectMatchesClahe(TemporalClahe& clahe, const cv::Mat& frame, const TemporalClahe::Config& cfg,
+                        const std::string& ctx)
+{
+    cv::Mat y, expected;
+    cv::extractChannel(frame, y, 0);
+    cv::createCLAHE(cfg.clipLimit, cv::Size(cfg.tilesX, cfg.tilesY))->apply(y, expected);
+
+    cv::Mat got = frame.clone();
+    clahe.apply(got, 0, cfg);
+    CHECK(clahe.lastRecomputedTiles() == cfg.tilesX * cfg.tilesY, ctx + " 应为全量重算");
+
+    cv::Mat gotY;
+    cv::extractChannel(got, gotY, 0);
+    CHECK(cv::norm(gotY, expected, cv::NORM_INF) == 0.0, ctx + " Y");
+    for (int c = 1; c < frame.channels(); ++c) {
+        cv::Mat a, b;
+        cv::extractChannel(got, a, c);
+        cv::extractChannel(frame, b, c);
+        CHECK(cv::norm(a, b, cv::NORM_INF) == 0.0, ctx + " 通道 " + std::to_string(c));
+    }
+}
+
+void testRefreshFrame(cv::RNG& rng)
+{
+    const cv::Size sizes[] = { { 320, 240 }, { 333, 251 }, { 320, 247 }, { 97, 64 } };
+    const cv::Size grids[] = { { 8, 8 }, { 4, 6 } };
+    for (const cv::Size& size : sizes) {
+        const cv::Mat frame = randomFrame(rng, size.height, size.width);
+        for (const cv::Size& grid : grids) {
+            for (double clip : { 2.0, 40.0, 0.0 }) {
+                TemporalClahe::Config cfg;
+                cfg.clipLimit = clip;
+                cfg.tilesX    = grid.width;
+                cfg.tilesY    = grid.height;
+                TemporalClahe clahe;
+                expectMatchesClahe(clahe, frame, cfg, describe("首帧", frame, cfg));
+            }
+        }
+    }
+}
+
+void testPeriodicRefresh(cv::RNG& rng)
+{
+    TemporalClahe::Config cfg;
+    cfg.refreshInterval = 3;
+    TemporalClahe clahe;
+
+    // 第 0、3 帧全量重算；中间帧复用缓存的 LUT，不要求与 cv::CLAHE 一致
+    const cv::Mat f0 = randomFrame(rng, 240, 320);
+    expectMatchesClahe(clahe, f0, cfg, describe("第 0 帧", f0, cfg));
+    for (int i = 1; i < 3; ++i) {
+        cv::Mat f = randomFrame(rng, 240, 320);
+        clahe.apply(f, 0, cfg);
+    }
+    const cv::Mat f3 = randomFrame(rng, 240, 320);
+    expectMatchesClahe(clahe, f3, cfg, describe("第 3 帧", f3, cfg));
+}
+
+} // namespace
+
+int main()
+{
+    cv::RNG rng(0xc1a4e);
+    testRefreshFrame(rng);
+    testPeriodicRefresh(rng);
+    return test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdio>
+#include <string>
+
+// 极简断言：失败时打印位置与上下文并计数，main 以 failures() 作为退出码（CTest 据此判定）
+namespace test {
+
+inline int& failures()
+{
+    static int n = 0;
+    return n;
+}
+
+inline void check(bool ok, const char* expr, const std::string& ctx, const char* file, int line)
+{
+    if (ok)
+        return;
+    ++failures();
+    std::fprintf(stderr, "%s:%d: CHECK(%s) 失败 %s\n", file, line, expr, ctx.c_str());
+}
+
+} // namespace test
+
+#define CHECK(cond, ctx) ::test::check(static_cast<bool>(cond), #cond, (ctx), __FILE__, __LINE__)
@@ -0,0 +1,93 @@
+// ThresholdFilter 对 BGR 输入的融合路径（Fixed / Otsu）与 cvtColor + cv::threshold 的逐位一致性
+// 融合路径是否生效取决于上游是否启用灰度滤镜，两种链路必须输出相同
+#include "TestCheck.h"
+#include "Filter/ThresholdFilter.h"
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <string>
+
+namespace {
+
+cv::Mat randomFrame(cv::RNG& rng, int rows, int cols)
+{
+    cv::Mat m(rows, cols, CV_8UC3);
+    rng.fill(m, cv::RNG::UNIFORM, 0, 256);
+    return m;
+}
+
+std::string describe(const char* kind, const cv::Mat& src, double value)
+{
+    return std::string(kind) + " " + std::to_string(src.cols) + "x" + std::to_string(src.rows)
+         + " value=" + std::to_string(value);
+}
+
+void expectIdentical(const cv::Mat& got, const cv::Mat& expected, const std::string& ctx)
+{
+    CHECK(got.size() == expected.size() && got.type() == expected.type(), ctx);
+    if (got.size() == expected.size() && got.type() == expected.type())
+        CHECK(cv::norm(got, expected, cv::NORM_INF) == 0.0, ctx);
+}
+
+cv::Mat reference(const cv::Mat& bgr, double value, int type)
+{
+    cv::Mat gray, out;
+    cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+    cv::threshold(gray, out, value, 255, type);
+    return out;
+}
+
+// 行数跨越行带边界（32 的整数倍 ±1）与奇数宽度
+const int kRows[] = { 1, 31, 32, 33, 97, 240 };
+const int kCols[] = { 1, 17, 320 };
+
+void testFixed(cv::RNG& rng)
+{
+    for (int rows : kRows) {
+        for (int cols : kCols) {
+            const cv::Mat src = randomFrame(rng, rows, cols);
+            for (double value : { 0.0, 90.5, 127.0, 254.0 }) {
+                ThresholdParams p;
+                p.type  = ThresholdType::Fixed;
+                p.value = value;
+                ThresholdFilter filter(p);
+                expectIdentical(filter.apply(src), reference(src, value, cv::THRESH_BINARY),
+                                describe("Fixed", src, value));
+            }
+        }
+    }
+}
+
+void testOtsu(cv::RNG& rng)
+{
+    ThresholdParams p;
+    p.type = ThresholdType::Otsu;
+    ThresholdFilter filter(p);
+    for (int rows : kRows) {
+        for (int cols : kCols) {
+            const cv::Mat src = randomFrame(rng, rows, cols);
+            expectIdentical(filter.apply(src),
+                            reference(src, 0.0, cv::THRESH_BINARY | cv::THRESH_OTSU),
+                            describe("Otsu", src, 0.0));
+        }
+    }
+
+    // 双峰场景：阈值落在两峰之间，灰度误差会直接改变 Otsu 选出的阈值
+    cv::Mat scene(120, 160, CV_8UC3, cv::Scalar(40, 60, 80));
+    cv::rectangle(scene, cv::Point(30, 20), cv::Point(120, 90), cv::Scalar(200, 170, 150), cv::FILLED);
+    cv::Mat noise(scene.size(), CV_MAKETYPE(CV_16S, 3));
+    rng.fill(noise, cv::RNG::NORMAL, 0, 12);
+    cv::add(scene, noise, scene, cv::noArray(), scene.type());
+    expectIdentical(filter.apply(scene),
+                    reference(scene, 0.0, cv::THRESH_BINARY | cv::THRESH_OTSU),
+                    describe("Otsu bimodal", scene, 0.0));
+}
+
+} // namespace
+
+int main()
+{
+    cv::RNG rng(0x7e5);
+    testFixed(rng);
+    testOtsu(rng);
+    return test::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// YoloPostprocessor::nms 与 cv::dnn::NMSBoxes 的随机对照
+// 覆盖网格路径（> 16 个候选）、退化框（宽/高 ≤ 0）与同分候选，要求保留下标及其顺序完全一致
+#include "TestCheck.h"
+#include "Detection/YoloPostprocess.h"
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kTrials = 400;
+
+struct Scene {
+    std::vector<cv::Rect> boxes;
+    std::vector<float>    scores;
+};
+
+// 候选数跨越网格启用阈值（16）；框或聚集在小区域内（大量相交），或散布在大画面上（跨多个网格单元）
+Scene randomScene(cv::RNG& rng)
+{
+    static const int kCounts[] = { 1, 8, 16, 17, 48, 300 };
+    const int  n      = kCounts[rng.uniform(0, static_cast<int>(sizeof(kCounts) / sizeof(kCounts[0])))];
+    const int  extent = rng.uniform(0, 2) ? 160 : 4000;
+    const bool ties   = rng.uniform(0, 2) != 0;
+
+    Scene s;
+    for (int i = 0; i < n; ++i) {
+        cv::Rect r(rng.uniform(-40, extent), rng.uniform(-40, extent),
+                   rng.uniform(1, 200), rng.uniform(1, 200));
+        switch (rng.uniform(0, 12)) {
+        case 0: r.width  = 0;                       break;   // 退化：零宽
+        case 1: r.height = 0;                       break;   // 退化：零高
+        case 2: r.width  = -rng.uniform(1, 20);     break;   // 退化：负宽
+        case 3: if (!s.boxes.empty())                        // 与已有框完全重合
+                    r = s.boxes[static_cast<std::size_t>(rng.uniform(0, static_cast<int>(s.boxes.size())))];
+                break;
+        default: break;
+        }
+        s.boxes.push_back(r);
+        // 同分：得分量化到 8 档，稳定排序须保持输入顺序
+        s.scores.push_back(ties ? rng.uniform(0, 8) / 8.0f : rng.uniform(0.0f, 1.0f));
+    }
+    return s;
+}
+
+std::string describe(int trial, const Scene& s, float scoreThresh, float nmsThresh)
+{
+    return "trial=" + std::to_string(trial) + " n=" + std::to_string(s.boxes.size())
+         + " score>" + std::to_string(scoreThresh) + " nms=" + std::to_string(nmsThresh);
+}
+
+void testAgainstNMSBoxes(cv::RNG& rng)
+{
+    static const float kScoreThresh[] = { 0.0f, 0.25f, 0.5f };
+    static const float kNmsThresh[]   = { 0.0f, 0.3f, 0.45f, 0.7f, 1.0f };
+
+    YoloPostprocessor post;   // 跨调用复用内部缓冲，同时验证缓冲复用不影响结果
+    std::vector<int> keep, expected;
+    for (int trial = 0; trial < kTrials; ++trial) {
+        const Scene s = randomScene(rng);
+        const float scoreThresh = kScoreThresh[rng.uniform(0, 3)];
+        const float nmsThresh   = kNmsThresh[rng.uniform(0, 5)];
+
+        cv::dnn::NMSBoxes(s.boxes, s.scores, scoreThresh, nmsThresh, expected);
+        post.nms(s.boxes, s.scores, scoreThresh, nmsThresh, keep);
+        CHECK(keep == expected, describe(trial, s, scoreThresh, nmsThresh));
+    }
+}
+
+// 全部候选同分、逐个平移的重叠框：按输入顺序处理，首个必被保留
+void testAllTied()
+{
+    Scene s;
+    for (int i = 0; i < 40; ++i) {
+        s.boxes.emplace_back(10 + i, 10 + i, 100, 100);
+        s.scores.push_back(0.5f);
+    }
+
+    YoloPostprocessor post;
+    std::vector<int> keep, expected;
+    cv::dnn::NMSBoxes(s.boxes, s.scores, 0.1f, 0.3f, expected);
+    post.nms(s.boxes, s.scores, 0.1f, 0.3f, keep);
+    CHECK(keep == expected, describe(-1, s, 0.1f, 0.3f));
+    CHECK(!keep.empty() && keep.front() == 0, describe(-1, s, 0.1f, 0.3f));
+}
+
+} // namespace
+
+int main()
+{
+    cv::RNG rng(0x4e4d53);
+    testAgainstNMSBoxes(rng);
+    testAllTied();
+    return test::failures() == 0 ? 0 : 1;
+}